@@ -0,0 +1,190 @@
+/*
+ * name: 无锁并发并查集
+ * description:
+ *
+ * 多个线程可以同时调用 find()、unite()、same()，不需要加锁。每个节点的父亲存为 std::atomic<uint32_t>。
+ *
+ * 合并（Jayanti–Tarjan 的随机优先级链接）：每个节点有一个固定的优先级（对编号做一次 32 位哈希，
+ * 相同时比较编号），合并时用 CAS 把优先级较低的根的父亲从自身改为另一个根；CAS 失败说明该根已被其他线程合并，
+ * 重新查找根后再试。父亲的优先级总是高于孩子，因此并发修改也不会形成环。
+ *
+ * 查找（路径分裂）：沿途用 CAS 把每个节点的父亲改为其祖父。CAS 失败说明父亲已被其他线程改成了更高的祖先，直接忽略即可。
+ *
+ * same() 在两次 find() 之间两个根可能被合并，因此若根不同，还需确认 x 的根仍是根，否则重试。
+ *
+ * parallel_connected_components() 把边表分块交给多个线程合并，再并行求出每个节点的根。编译时需要加 -pthread。
+ *
+ * 要求节点数小于 2^32
+ *
+ * 时间复杂度：期望每个操作几乎为$O(1)$
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 元素少于该值时不开线程
+#define PARALLEL_GRAIN 4096
+
+class ConcurrentDisjointSet {
+  private:
+    std::vector<std::atomic<uint32_t>> parent;
+
+    // MurmurHash3 的 fmix32
+    static uint32_t priority(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x85EBCA6BU;
+        x ^= x >> 13;
+        x *= 0xC2B2AE35U;
+        x ^= x >> 16;
+        return x;
+    }
+
+    static bool lower_priority(uint32_t x, uint32_t y) {
+        uint32_t px = priority(x);
+        uint32_t py = priority(y);
+
+        return px < py || (px == py && x < y);
+    }
+
+  public:
+    explicit ConcurrentDisjointSet(size_t size) : parent(size) {
+        for (size_t i = 0; i < size; i++) {
+            parent[i].store((uint32_t)i, std::memory_order_relaxed);
+        }
+    }
+
+    size_t size() const { return parent.size(); }
+
+    // 查询对应元素的根节点（+路径分裂）
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t p = parent[x].load(std::memory_order_relaxed);
+
+            if (p == x) {
+                return x;
+            }
+
+            uint32_t grandparent = parent[p].load(std::memory_order_relaxed);
+
+            if (p != grandparent) {
+                parent[x].compare_exchange_weak(p, grandparent,
+                                                std::memory_order_relaxed);
+            }
+
+            x = p;
+        }
+    }
+
+    bool same(uint32_t x, uint32_t y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+
+            if (x == y) {
+                return true;
+            }
+
+            if (parent[x].load(std::memory_order_relaxed) == x) {
+                return false;
+            }
+        }
+    }
+
+    // 合并两个元素所属的集合，已在同一集合时返回 false
+    bool unite(uint32_t x, uint32_t y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+
+            if (x == y) {
+                return false;
+            }
+
+            if (lower_priority(x, y)) {
+                std::swap(x, y);
+            }
+
+            // y 的优先级较低，挂到 x 下
+            uint32_t expected = y;
+
+            if (parent[y].compare_exchange_strong(expected, x,
+                                                  std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+};
+
+// 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+// 元素较少时直接在当前线程执行，避免创建线程的开销
+template <typename Fn>
+void parallel_for(size_t count, size_t thread_count, Fn &&fn) {
+    if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+        fn((size_t)0, (size_t)0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+
+    size_t chunk = (count + thread_count - 1) / thread_count;
+
+    for (size_t t = 0; t < thread_count; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+
+        threads.emplace_back([&fn, t, begin, end]() { fn(t, begin, end); });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+struct ComponentsResult {
+    size_t component_count;
+    // 节点所在连通块的根
+    std::vector<uint32_t> root;
+};
+
+ComponentsResult parallel_connected_components(
+    size_t node_count, std::vector<std::pair<uint32_t, uint32_t>> const &edges,
+    size_t thread_count) {
+    ConcurrentDisjointSet set(node_count);
+
+    parallel_for(edges.size(), thread_count,
+                 [&](size_t, size_t begin, size_t end) {
+                     for (size_t i = begin; i < end; i++) {
+                         set.unite(edges[i].first, edges[i].second);
+                     }
+                 });
+
+    std::vector<uint32_t> root;
+    root.resize(node_count);
+
+    std::vector<size_t> root_count;
+    root_count.resize(std::max<size_t>(thread_count, 1), 0);
+
+    parallel_for(node_count, thread_count,
+                 [&](size_t thread_id, size_t begin, size_t end) {
+                     for (size_t v = begin; v < end; v++) {
+                         root[v] = set.find((uint32_t)v);
+
+                         if (root[v] == v) {
+                             root_count[thread_id]++;
+                         }
+                     }
+                 });
+
+    size_t component_count = 0;
+    for (size_t count : root_count) {
+        component_count += count;
+    }
+
+    return {component_count, root};
+}
@@ -6,11 +6,17 @@
  *
  * 每个操作的平均时间几乎为$O(1)$
  *
+ * CompactDisjointSet 只用一个数组：根节点存 ROOT_FLAG（最高位）与集合大小，其他节点存父亲。
+ * 下标类型默认为 uint32_t，每个元素只占 4 字节，find 只是几次连续的读写。要求元素个数小于下标类型最大值的一半
+ *
  * Verdict: P3367: https://www.luogu.com.cn/record/189760008
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <numeric>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using std::size_t;
@@ -28,17 +34,11 @@ struct DisjointSet {
         std::iota(std::begin(set), std::end(set), 0);
     }
 
-    // 查询对应元素的根节点（+路径压缩）
+    // 查询对应元素的根节点（+路径减半：每个节点改指向其祖父）
     size_t find(size_t x) {
-        std::vector<size_t> path(16);
-
         while (set[x] != x) {
-            path.push_back(x);
+            set[x] = set[set[x]];
             x = set[x];
-        };
-
-        for (size_t node : path) {
-            set[node] = x;
         }
 
         return x;
@@ -61,4 +61,62 @@ struct DisjointSet {
             set_size[x_root] += set_size[y_root];
         }
     }
-};
\ No newline at end of file
+};
+
+template <typename Index = uint32_t>
+class CompactDisjointSet {
+    static_assert(std::is_unsigned<Index>::value,
+                  "Index must be an unsigned integer type");
+
+  private:
+    static constexpr Index ROOT_FLAG = (Index)1 << (sizeof(Index) * 8 - 1);
+
+    std::vector<Index> node;
+
+    bool is_root(Index x) const { return (node[x] & ROOT_FLAG) != 0; }
+
+  public:
+    explicit CompactDisjointSet(size_t size)
+        : node(size, (Index)(ROOT_FLAG | 1)) {}
+
+    // 查询对应元素的根节点（+路径减半）
+    Index find(Index x) {
+        while (!is_root(x)) {
+            Index parent = node[x];
+
+            if (is_root(parent)) {
+                return parent;
+            }
+
+            node[x] = node[parent];
+            x = node[parent];
+        }
+
+        return x;
+    }
+
+    // 合并两个元素所属的集合（+按大小合并），已在同一集合时返回 false
+    bool unite(Index x, Index y) {
+        Index x_root = find(x);
+        Index y_root = find(y);
+
+        if (x_root == y_root) {
+            return false;
+        }
+
+        // 两个根的 ROOT_FLAG 相同，直接比较即为比较集合大小
+        if (node[x_root] < node[y_root]) {
+            std::swap(x_root, y_root);
+        }
+
+        node[x_root] += node[y_root] & ~ROOT_FLAG;
+        node[y_root] = x_root;
+
+        return true;
+    }
+
+    bool same(Index x, Index y) { return find(x) == find(y); }
+
+    // 元素所属集合的大小
+    size_t size_of(Index x) { return node[find(x)] & ~ROOT_FLAG; }
+};
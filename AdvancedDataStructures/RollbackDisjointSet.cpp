@@ -0,0 +1,231 @@
+/*
+ * name: 可撤销并查集、离线动态连通性
+ * description:
+ *
+ * 可撤销并查集：按秩合并、不做路径压缩，因此每次合并只修改一个根的父亲（以及可能另一个根的秩），
+ * 把修改记录在栈中即可撤销。checkpoint() 返回当前栈高，rollback() 撤销该时刻之后的所有合并。
+ * 树高不超过$\log{N}$，find 为$O(\log{N})$。
+ *
+ * 离线动态连通性（线段树分治）：把操作序列中的询问依次编号为 $0, 1, \ldots, q - 1$，每条边的存在时间
+ * 对应询问编号上的一个区间，将其挂到线段树上$O(\log{q})$个节点。DFS 线段树时进入节点合并其上的边，
+ * 离开节点时回滚，到达叶子时回答该询问。同一条边（不区分方向）可以同时存在多份，每次删除只删去其中一份。
+ *
+ * 时间复杂度：可撤销并查集单次操作$O(\log{N})$；动态连通性$O(N + (M + q) \log{q} \log{N})$，M 为加边次数
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+struct RollbackDisjointSet {
+    // 节点i的父亲
+    std::vector<size_t> set;
+
+    // 以节点i为根的树的秩（树高的上界）
+    std::vector<size_t> rank;
+
+    size_t component_count;
+
+    // 每次成功的合并记录 (被挂上去的根, 另一个根的秩是否增加)
+    std::vector<std::pair<size_t, bool>> history;
+
+    explicit RollbackDisjointSet(size_t size) : component_count{size} {
+        set.resize(size);
+        rank.resize(size, 0);
+        std::iota(std::begin(set), std::end(set), 0);
+    }
+
+    // 查询对应元素的根节点（不做路径压缩）
+    size_t find(size_t x) const {
+        while (set[x] != x) {
+            x = set[x];
+        }
+
+        return x;
+    }
+
+    bool same(size_t x, size_t y) const { return find(x) == find(y); }
+
+    // 合并两个元素所属的集合（+按秩合并），已在同一集合时返回 false，不产生记录
+    bool unite(size_t x, size_t y) {
+        size_t x_root = find(x);
+        size_t y_root = find(y);
+
+        if (x_root == y_root) {
+            return false;
+        }
+
+        if (rank[x_root] < rank[y_root]) {
+            std::swap(x_root, y_root);
+        }
+
+        bool rank_increased = rank[x_root] == rank[y_root];
+
+        set[y_root] = x_root;
+        if (rank_increased) {
+            rank[x_root]++;
+        }
+        component_count--;
+
+        history.emplace_back(y_root, rank_increased);
+
+        return true;
+    }
+
+    size_t checkpoint() const { return history.size(); }
+
+    // 撤销 checkpoint() 返回 point 之后的所有合并
+    void rollback(size_t point) {
+        while (history.size() > point) {
+            size_t y_root = history.back().first;
+            size_t x_root = set[y_root];
+
+            if (history.back().second) {
+                rank[x_root]--;
+            }
+
+            set[y_root] = y_root;
+            component_count++;
+
+            history.pop_back();
+        }
+    }
+};
+
+class OfflineDynamicConnectivity {
+  private:
+    struct Interval {
+        size_t from;
+        size_t to;
+        // 存在于第 [begin, end) 个询问
+        size_t begin;
+        size_t end;
+    };
+
+    size_t node_count;
+    std::vector<std::pair<size_t, size_t>> queries;
+    std::vector<Interval> intervals;
+
+    // 尚未删除的边 -> 各份的加入时刻（以当时已有的询问个数表示）
+    std::map<std::pair<size_t, size_t>, std::vector<size_t>> alive;
+
+    std::vector<std::vector<std::pair<size_t, size_t>>> tree;
+
+  public:
+    explicit OfflineDynamicConnectivity(size_t node_count_)
+        : node_count{node_count_} {}
+
+    void add_edge(size_t from, size_t to) {
+        alive[normalize(from, to)].push_back(queries.size());
+    }
+
+    // 删除一份 (from, to)，不存在时忽略
+    void remove_edge(size_t from, size_t to) {
+        auto it = alive.find(normalize(from, to));
+
+        if (it == alive.end()) {
+            return;
+        }
+
+        // 各份边等价，删去任意一份都相同
+        size_t begin = it->second.back();
+        it->second.pop_back();
+
+        intervals.push_back({it->first.first, it->first.second, begin,
+                             queries.size()});
+
+        if (it->second.empty()) {
+            alive.erase(it);
+        }
+    }
+
+    // 询问当前时刻 x、y 是否连通，返回询问的编号
+    size_t add_query(size_t x, size_t y) {
+        queries.emplace_back(x, y);
+        return queries.size() - 1;
+    }
+
+    // 返回值的第 i 个元素为第 i 个询问的答案（1 表示连通）
+    std::vector<int> solve() {
+        size_t query_count = queries.size();
+
+        std::vector<int> answer;
+        answer.resize(query_count, 0);
+
+        if (query_count == 0) {
+            return answer;
+        }
+
+        std::vector<Interval> all = intervals;
+
+        for (auto const &entry : alive) {
+            for (size_t begin : entry.second) {
+                all.push_back({entry.first.first, entry.first.second, begin,
+                               query_count});
+            }
+        }
+
+        tree.assign(4 * query_count, {});
+
+        for (Interval const &interval : all) {
+            if (interval.begin < interval.end) {
+                insert(1, 0, query_count, interval);
+            }
+        }
+
+        RollbackDisjointSet set(node_count);
+        dfs(1, 0, query_count, set, answer);
+
+        tree.clear();
+
+        return answer;
+    }
+
+  private:
+    static std::pair<size_t, size_t> normalize(size_t from, size_t to) {
+        return {std::min(from, to), std::max(from, to)};
+    }
+
+    // 节点 node 管辖询问 [left, right)
+    void insert(size_t node, size_t left, size_t right,
+                Interval const &interval) {
+        if (interval.begin <= left && right <= interval.end) {
+            tree[node].emplace_back(interval.from, interval.to);
+            return;
+        }
+
+        size_t mid = left + (right - left) / 2;
+
+        if (interval.begin < mid) {
+            insert(2 * node, left, mid, interval);
+        }
+
+        if (mid < interval.end) {
+            insert(2 * node + 1, mid, right, interval);
+        }
+    }
+
+    void dfs(size_t node, size_t left, size_t right, RollbackDisjointSet &set,
+             std::vector<int> &answer) {
+        size_t point = set.checkpoint();
+
+        for (std::pair<size_t, size_t> const &edge : tree[node]) {
+            set.unite(edge.first, edge.second);
+        }
+
+        if (right - left == 1) {
+            answer[left] =
+                set.same(queries[left].first, queries[left].second) ? 1 : 0;
+        } else {
+            size_t mid = left + (right - left) / 2;
+
+            dfs(2 * node, left, mid, set, answer);
+            dfs(2 * node + 1, mid, right, set, answer);
+        }
+
+        set.rollback(point);
+    }
+};
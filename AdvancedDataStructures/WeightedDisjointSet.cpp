@@ -0,0 +1,152 @@
+/*
+ * name: 带权并查集（势能并查集）
+ * description:
+ *
+ * 维护形如 $x_a - x_b = w$ 的相对约束，并判断新约束是否与已有约束矛盾。
+ *
+ * 每个节点额外记录到父亲的势能 potential[x] = $x - parent(x)$，路径上的势能相加即为到根的势能。
+ * 路径压缩分两趟进行：第一趟找到根并求出起点到根的势能之和，第二趟从起点重新走一遍，
+ * 把每个节点直接挂到根上并改写为其到根的势能，不需要递归或额外的数组。
+ *
+ * 势能所在的集合只需是一个交换群，由模板参数 Group 给出（identity、op、inverse），例如：
+ * - AdditiveGroup：整数加法，表示差值约束
+ * - XorGroup：按位异或，表示奇偶性（同类/异类）约束
+ * - ModularGroup：模 P 加法，表示模意义下的差值约束
+ *
+ * 时间复杂度：每个操作的平均时间几乎为$O(1)$
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+template <typename T = long long>
+struct AdditiveGroup {
+    using value_type = T;
+
+    static T identity() { return 0; }
+    static T op(T a, T b) { return a + b; }
+    static T inverse(T a) { return -a; }
+};
+
+template <typename T = uint64_t>
+struct XorGroup {
+    using value_type = T;
+
+    static T identity() { return 0; }
+    static T op(T a, T b) { return a ^ b; }
+    static T inverse(T a) { return a; }
+};
+
+// 要求 0 < P < 2^62，参与运算的值在 [0, P) 内
+template <long long P>
+struct ModularGroup {
+    using value_type = long long;
+
+    static long long identity() { return 0; }
+    static long long op(long long a, long long b) {
+        return a + b >= P ? a + b - P : a + b;
+    }
+    static long long inverse(long long a) { return a == 0 ? 0 : P - a; }
+};
+
+template <typename Group>
+struct WeightedDisjointSet {
+    using value_type = typename Group::value_type;
+
+    // 节点i的父亲
+    std::vector<size_t> set;
+
+    // 以节点i为树根的子树的大小
+    std::vector<size_t> set_size;
+
+    // 节点i减去其父亲的势能
+    std::vector<value_type> potential;
+
+    explicit WeightedDisjointSet(size_t size) {
+        set.resize(size);
+        set_size.resize(size, 1);
+        potential.resize(size, Group::identity());
+        std::iota(std::begin(set), std::end(set), 0);
+    }
+
+    // 查询对应元素的根节点（+路径压缩），同时求出 x 减去根的势能
+    std::pair<size_t, value_type> find(size_t x) {
+        size_t root = x;
+        value_type total = Group::identity();
+
+        while (set[root] != root) {
+            total = Group::op(total, potential[root]);
+            root = set[root];
+        }
+
+        // 第二趟：remaining 为当前节点到根的势能
+        value_type remaining = total;
+
+        while (set[x] != root && set[x] != x) {
+            size_t next = set[x];
+            value_type to_parent = potential[x];
+
+            set[x] = root;
+            potential[x] = remaining;
+
+            remaining = Group::op(remaining, Group::inverse(to_parent));
+            x = next;
+        }
+
+        return {root, total};
+    }
+
+    bool same(size_t x, size_t y) { return find(x).first == find(y).first; }
+
+    // 加入约束 x - y = w（+启发式合并），与已有约束矛盾时返回 false
+    bool unite(size_t x, size_t y, value_type w) {
+        std::pair<size_t, value_type> x_info = find(x);
+        std::pair<size_t, value_type> y_info = find(y);
+
+        size_t x_root = x_info.first;
+        size_t y_root = y_info.first;
+
+        // y_root - x_root
+        value_type delta =
+            Group::op(Group::op(x_info.second, Group::inverse(y_info.second)),
+                      Group::inverse(w));
+
+        if (x_root == y_root) {
+            return delta == Group::identity();
+        }
+
+        if (set_size[x_root] < set_size[y_root]) {
+            set[x_root] = y_root;
+            potential[x_root] = Group::inverse(delta);
+            set_size[y_root] += set_size[x_root];
+        } else {
+            set[y_root] = x_root;
+            potential[y_root] = delta;
+            set_size[x_root] += set_size[y_root];
+        }
+
+        return true;
+    }
+
+    struct DiffResult {
+        // x、y 不在同一集合时为 false，此时差值不确定
+        bool valid;
+        value_type value;
+    };
+
+    // x - y
+    DiffResult diff(size_t x, size_t y) {
+        std::pair<size_t, value_type> x_info = find(x);
+        std::pair<size_t, value_type> y_info = find(y);
+
+        if (x_info.first != y_info.first) {
+            return {false, Group::identity()};
+        }
+
+        return {true,
+                Group::op(x_info.second, Group::inverse(y_info.second))};
+    }
+};
@@ -0,0 +1,293 @@
+/*
+ * name: 并行 Borůvka 算法
+ * description:
+ *
+ * Borůvka 算法，用于计算最小生成树（图不连通时为最小生成森林）。每一轮：
+ * 1. 并行扫描剩余的边，为每个连通块求出权值最小的出边。边的键为 (边权, 边的编号) 打包成的 64 位整数，
+ *    用原子的取最小值操作更新，因此边权相同时总是选编号较小的边，结果与线程的调度无关
+ * 2. 并行地把每个连通块与其最小出边的另一端合并（无锁并发并查集）。在上述全序下最小生成树唯一，
+ *    所选的边不会成环；两个连通块选中同一条边时只有一次合并成功，该边只被记录一次
+ * 3. 把剩余边的两端改写为所在连通块的根，删去两端已在同一连通块中的边
+ *
+ * 每一轮连通块个数至少减半，最多$\log{V}$轮。总权值与 kruskal() 相同。
+ *
+ * 与 Kruskal.cpp 相同，节点编号为 1 到 node_count。与 kruskal_radix()、filter_kruskal() 一样，
+ * boruvka() 仅作为库函数提供，本文件没有 main()。编译时需要加 -pthread。
+ * 要求节点数与边数都小于 2^32
+ *
+ * 时间复杂度：$O((E + V) \log{V} / T)$，T 为线程数
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 元素少于该值时不开线程
+#define PARALLEL_GRAIN 4096
+
+struct Edge {
+    size_t from;
+    size_t to;
+    int weight;
+
+    explicit constexpr Edge(size_t from_, size_t to_, int weight_)
+        : from{from_}, to{to_}, weight{weight_} {};
+};
+
+class ConcurrentDisjointSet {
+  private:
+    std::vector<std::atomic<uint32_t>> parent;
+
+    // MurmurHash3 的 fmix32
+    static uint32_t priority(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x85EBCA6BU;
+        x ^= x >> 13;
+        x *= 0xC2B2AE35U;
+        x ^= x >> 16;
+        return x;
+    }
+
+    static bool lower_priority(uint32_t x, uint32_t y) {
+        uint32_t px = priority(x);
+        uint32_t py = priority(y);
+
+        return px < py || (px == py && x < y);
+    }
+
+  public:
+    explicit ConcurrentDisjointSet(size_t size) : parent(size) {
+        for (size_t i = 0; i < size; i++) {
+            parent[i].store((uint32_t)i, std::memory_order_relaxed);
+        }
+    }
+
+    // 查询对应元素的根节点（+路径分裂）
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t p = parent[x].load(std::memory_order_relaxed);
+
+            if (p == x) {
+                return x;
+            }
+
+            uint32_t grandparent = parent[p].load(std::memory_order_relaxed);
+
+            if (p != grandparent) {
+                parent[x].compare_exchange_weak(p, grandparent,
+                                                std::memory_order_relaxed);
+            }
+
+            x = p;
+        }
+    }
+
+    // 合并两个元素所属的集合，已在同一集合时返回 false
+    bool unite(uint32_t x, uint32_t y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+
+            if (x == y) {
+                return false;
+            }
+
+            if (lower_priority(x, y)) {
+                std::swap(x, y);
+            }
+
+            uint32_t expected = y;
+
+            if (parent[y].compare_exchange_strong(expected, x,
+                                                  std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+};
+
+// 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+// 元素较少时直接在当前线程执行，避免创建线程的开销
+template <typename Fn>
+void parallel_for(size_t count, size_t thread_count, Fn &&fn) {
+    if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+        fn((size_t)0, (size_t)0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+
+    size_t chunk = (count + thread_count - 1) / thread_count;
+
+    for (size_t t = 0; t < thread_count; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+
+        threads.emplace_back([&fn, t, begin, end]() { fn(t, begin, end); });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+// 原子地令 target = min(target, value)
+void atomic_min(std::atomic<uint64_t> &target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+
+    while (value < current) {
+        if (target.compare_exchange_weak(current, value,
+                                         std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// 并行地保留 list 中满足 keep(x) 的元素（保持相对顺序），返回保留的个数
+template <typename Keep>
+size_t parallel_filter(std::vector<uint32_t> &list, size_t thread_count,
+                       Keep &&keep) {
+    std::vector<size_t> kept;
+    std::vector<size_t> chunk_begin;
+    kept.resize(thread_count, 0);
+    chunk_begin.resize(thread_count, 0);
+
+    parallel_for(list.size(), thread_count,
+                 [&](size_t thread_id, size_t begin, size_t end) {
+                     size_t write = begin;
+
+                     for (size_t i = begin; i < end; i++) {
+                         if (keep(list[i])) {
+                             list[write++] = list[i];
+                         }
+                     }
+
+                     chunk_begin[thread_id] = begin;
+                     kept[thread_id] = write - begin;
+                 });
+
+    size_t total = 0;
+
+    for (size_t t = 0; t < thread_count; t++) {
+        if (kept[t] > 0 && chunk_begin[t] != total) {
+            std::copy(std::begin(list) + (std::ptrdiff_t)chunk_begin[t],
+                      std::begin(list) +
+                          (std::ptrdiff_t)(chunk_begin[t] + kept[t]),
+                      std::begin(list) + (std::ptrdiff_t)total);
+        }
+
+        total += kept[t];
+    }
+
+    list.resize(total);
+
+    return total;
+}
+
+std::vector<Edge> boruvka(std::vector<Edge> const &edge_list,
+                          size_t node_count, size_t thread_count) {
+    uint64_t const NO_EDGE = ~(uint64_t)0;
+
+    thread_count = std::max<size_t>(thread_count, 1);
+
+    size_t edge_count = edge_list.size();
+
+    ConcurrentDisjointSet set(node_count + 1);
+
+    // 各边两端当前所在连通块的根
+    std::vector<uint32_t> from_root;
+    std::vector<uint32_t> to_root;
+    from_root.resize(edge_count);
+    to_root.resize(edge_count);
+
+    // 剩余的边的编号、当前各连通块的根
+    std::vector<uint32_t> active_edges;
+    std::vector<uint32_t> components;
+    active_edges.resize(edge_count);
+    components.resize(node_count + 1);
+
+    std::iota(std::begin(active_edges), std::end(active_edges), 0);
+    std::iota(std::begin(components), std::end(components), 0);
+
+    for (size_t i = 0; i < edge_count; i++) {
+        from_root[i] = (uint32_t)edge_list[i].from;
+        to_root[i] = (uint32_t)edge_list[i].to;
+    }
+
+    // 连通块的最小出边的键
+    std::vector<std::atomic<uint64_t>> best(node_count + 1);
+    for (std::atomic<uint64_t> &key : best) {
+        key.store(NO_EDGE, std::memory_order_relaxed);
+    }
+
+    std::vector<std::vector<Edge>> chosen(thread_count);
+
+    auto edge_key = [&](uint32_t id) {
+        uint32_t weight = (uint32_t)edge_list[id].weight ^ 0x80000000U;
+
+        return ((uint64_t)weight << 32) | id;
+    };
+
+    // 自环不会被选中
+    parallel_filter(active_edges, thread_count,
+                    [&](uint32_t id) { return from_root[id] != to_root[id]; });
+
+    while (!active_edges.empty()) {
+        parallel_for(active_edges.size(), thread_count,
+                     [&](size_t, size_t begin, size_t end) {
+                         for (size_t i = begin; i < end; i++) {
+                             uint32_t id = active_edges[i];
+                             uint64_t key = edge_key(id);
+
+                             atomic_min(best[from_root[id]], key);
+                             atomic_min(best[to_root[id]], key);
+                         }
+                     });
+
+        parallel_for(
+            components.size(), thread_count,
+            [&](size_t thread_id, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t c = components[i];
+                    uint64_t key = best[c].load(std::memory_order_relaxed);
+
+                    if (key == NO_EDGE) {
+                        continue;
+                    }
+
+                    uint32_t id = (uint32_t)(key & 0xFFFFFFFFU);
+
+                    if (set.unite(from_root[id], to_root[id])) {
+                        chosen[thread_id].push_back(edge_list[id]);
+                    }
+                }
+            });
+
+        // 重置本轮用过的键，并只保留仍为根的连通块
+        parallel_filter(components, thread_count, [&](uint32_t c) {
+            best[c].store(NO_EDGE, std::memory_order_relaxed);
+            return set.find(c) == c;
+        });
+
+        parallel_filter(active_edges, thread_count, [&](uint32_t id) {
+            from_root[id] = set.find(from_root[id]);
+            to_root[id] = set.find(to_root[id]);
+
+            return from_root[id] != to_root[id];
+        });
+    }
+
+    std::vector<Edge> result;
+
+    for (std::vector<Edge> const &part : chosen) {
+        result.insert(std::end(result), std::begin(part), std::end(part));
+    }
+
+    return result;
+}
@@ -6,14 +6,35 @@
  *
  * 时间复杂度：$O(E \log E + E \alpha(V))$。
  *
+ * kruskal_radix()：边权为 int，用 LSD 基数排序（每趟 8 位，符号位取反后按无符号数排序）代替比较排序，
+ * 所有边在某一字节上都相同时跳过该趟。时间复杂度：$O(E + E \alpha(V))$。
+ *
+ * filter_kruskal()：仿照快速选择，按随机选取的枢轴把边分为较轻、较重两部分，先递归处理较轻的部分；
+ * 之后较重的部分中两端已连通的边一定不在最小生成树中，先并行地把它们过滤掉，再递归处理剩下的边。
+ * 已经选够 $V - 1$ 条边时直接返回，因此大多数较重的边既不需要排序也不需要合并。
+ * 过滤时只读取并查集，使用不做路径压缩的 find_root()，可以由多个线程同时进行。编译时需要加 -pthread。
+ *
+ * kruskal_radix()、filter_kruskal() 仅作为库函数提供，接口与 kruskal() 相同，所得总权值也相同；
+ * main() 只调用 kruskal()，Verdict 对应的也是 kruskal()。
+ *
  * Verdict: P3366: https://www.luogu.com.cn/record/189763566
  */
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <numeric>
+#include <random>
+#include <thread>
 #include <vector>
 
+// 元素少于该值时不开线程
+#define PARALLEL_GRAIN 4096
+
+// filter_kruskal() 中边数少于该值时直接排序
+#define FILTER_KRUSKAL_THRESHOLD 1024
+
 struct DisjointSet {
     std::vector<size_t> set;
     std::vector<size_t> set_size;
@@ -25,15 +46,18 @@ struct DisjointSet {
     }
 
     size_t find(size_t x) {
-        std::vector<size_t> path(16);
-
         while (set[x] != x) {
-            path.push_back(x);
+            set[x] = set[set[x]];
             x = set[x];
-        };
+        }
+
+        return x;
+    }
 
-        for (size_t node : path) {
-            set[node] = x;
+    // 不修改并查集，可以由多个线程同时调用
+    size_t find_root(size_t x) const {
+        while (set[x] != x) {
+            x = set[x];
         }
 
         return x;
@@ -69,6 +93,10 @@ struct Edge {
 };
 
 std::vector<Edge> kruskal(std::vector<Edge> &edge_list, size_t node_count);
+std::vector<Edge> kruskal_radix(std::vector<Edge> &edge_list,
+                                size_t node_count);
+std::vector<Edge> filter_kruskal(std::vector<Edge> &edge_list,
+                                 size_t node_count, size_t thread_count);
 
 int main(void) {
     size_t node_count, edge_count;
@@ -130,4 +158,228 @@ std::vector<Edge> kruskal(std::vector<Edge> &edge_list, size_t node_count) {
     }
 
     return result;
-}
\ No newline at end of file
+}
+
+// 按边权升序的 LSD 基数排序（稳定），buffer 为临时空间
+void radix_sort_edges(Edge *first, Edge *last, std::vector<Edge> &buffer) {
+    size_t n = (size_t)(last - first);
+
+    if (n < 2) {
+        return;
+    }
+
+    auto key = [](Edge const &edge) {
+        return (uint32_t)edge.weight ^ 0x80000000U;
+    };
+
+    size_t count[4][256] = {};
+
+    for (Edge const *edge = first; edge != last; edge++) {
+        uint32_t k = key(*edge);
+
+        for (size_t pass = 0; pass < 4; pass++) {
+            count[pass][(k >> (8 * pass)) & 0xFF]++;
+        }
+    }
+
+    buffer.assign(first, last);
+
+    Edge *source = first;
+    Edge *target = buffer.data();
+
+    for (size_t pass = 0; pass < 4; pass++) {
+        size_t shift = 8 * pass;
+
+        if (count[pass][(key(*source) >> shift) & 0xFF] == n) {
+            continue;
+        }
+
+        size_t position[256];
+        size_t sum = 0;
+
+        for (size_t digit = 0; digit < 256; digit++) {
+            position[digit] = sum;
+            sum += count[pass][digit];
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            target[position[(key(source[i]) >> shift) & 0xFF]++] = source[i];
+        }
+
+        std::swap(source, target);
+    }
+
+    if (source != first) {
+        std::copy(source, source + n, first);
+    }
+}
+
+// 按边权升序扫描 [first, last)，把连接两个不同集合的边加入 result，选够时提前结束
+void kruskal_scan(Edge const *first, Edge const *last, DisjointSet &set,
+                  std::vector<Edge> &result, size_t node_count) {
+    for (Edge const *edge = first; edge != last; edge++) {
+        if (result.size() >= node_count - 1) {
+            return;
+        }
+
+        size_t from_root = set.find(edge->from);
+        size_t to_root = set.find(edge->to);
+
+        if (from_root != to_root) {
+            result.push_back(*edge);
+            set.unite(from_root, to_root);
+        }
+    }
+}
+
+std::vector<Edge> kruskal_radix(std::vector<Edge> &edge_list,
+                                size_t node_count) {
+    std::vector<Edge> buffer;
+    radix_sort_edges(edge_list.data(), edge_list.data() + edge_list.size(),
+                     buffer);
+
+    DisjointSet set{node_count + 1};
+
+    std::vector<Edge> result;
+    result.reserve(node_count);
+
+    kruskal_scan(edge_list.data(), edge_list.data() + edge_list.size(), set,
+                 result, node_count);
+
+    return result;
+}
+
+// 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+// 元素较少时直接在当前线程执行，避免创建线程的开销
+template <typename Fn>
+void parallel_for(size_t count, size_t thread_count, Fn &&fn) {
+    if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+        fn((size_t)0, (size_t)0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+
+    size_t chunk = (count + thread_count - 1) / thread_count;
+
+    for (size_t t = 0; t < thread_count; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+
+        threads.emplace_back([&fn, t, begin, end]() { fn(t, begin, end); });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+// 并行删去 [first, first + n) 中两端已连通的边，保留的边移到前面，返回保留的条数
+size_t filter_connected(Edge *first, size_t n, DisjointSet const &set,
+                        size_t thread_count) {
+    thread_count = std::max<size_t>(thread_count, 1);
+
+    // 各段先在段内压缩，记录保留的条数
+    std::vector<size_t> kept;
+    std::vector<size_t> chunk_begin;
+    kept.resize(thread_count, 0);
+    chunk_begin.resize(thread_count, n);
+
+    parallel_for(n, thread_count,
+                 [&](size_t thread_id, size_t begin, size_t end) {
+                     size_t write = begin;
+
+                     for (size_t i = begin; i < end; i++) {
+                         if (set.find_root(first[i].from) !=
+                             set.find_root(first[i].to)) {
+                             first[write++] = first[i];
+                         }
+                     }
+
+                     chunk_begin[thread_id] = begin;
+                     kept[thread_id] = write - begin;
+                 });
+
+    size_t total = 0;
+
+    for (size_t t = 0; t < thread_count; t++) {
+        if (kept[t] > 0 && chunk_begin[t] != total) {
+            std::copy(first + chunk_begin[t],
+                      first + chunk_begin[t] + kept[t], first + total);
+        }
+
+        total += kept[t];
+    }
+
+    return total;
+}
+
+// 只对较轻的部分递归，较重的部分在循环中处理。枢轴随机选取，递归深度期望为$O(\log{E})$
+void filter_kruskal_recurse(Edge *first, size_t n, DisjointSet &set,
+                            std::vector<Edge> &result, size_t node_count,
+                            size_t thread_count, std::vector<Edge> &buffer,
+                            std::mt19937 &urbg) {
+    while (n > 0 && result.size() < node_count - 1) {
+        if (n < FILTER_KRUSKAL_THRESHOLD) {
+            radix_sort_edges(first, first + n, buffer);
+            kruskal_scan(first, first + n, set, result, node_count);
+            return;
+        }
+
+        // 随机取三条边，以其边权的中位数作为枢轴
+        std::uniform_int_distribution<size_t> distr{0, n - 1};
+        int a = first[distr(urbg)].weight;
+        int b = first[distr(urbg)].weight;
+        int c = first[distr(urbg)].weight;
+        int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+        Edge *middle =
+            std::partition(first, first + n, [pivot](Edge const &edge) {
+                return edge.weight < pivot;
+            });
+
+        // 枢轴为最小值时改为按 <= 划分，仍无法划分说明边权全部相同
+        if (middle == first) {
+            middle =
+                std::partition(first, first + n, [pivot](Edge const &edge) {
+                    return edge.weight <= pivot;
+                });
+
+            if (middle == first + n) {
+                kruskal_scan(first, first + n, set, result, node_count);
+                return;
+            }
+        }
+
+        size_t light_count = (size_t)(middle - first);
+
+        filter_kruskal_recurse(first, light_count, set, result, node_count,
+                               thread_count, buffer, urbg);
+
+        if (result.size() >= node_count - 1) {
+            return;
+        }
+
+        first = middle;
+        n = filter_connected(middle, n - light_count, set, thread_count);
+    }
+}
+
+// edge_list 会被重排，其中被过滤掉的位置内容不确定
+std::vector<Edge> filter_kruskal(std::vector<Edge> &edge_list,
+                                 size_t node_count, size_t thread_count) {
+    DisjointSet set{node_count + 1};
+
+    std::vector<Edge> result;
+    result.reserve(node_count);
+
+    std::vector<Edge> buffer;
+
+    std::mt19937 urbg{84841984};
+
+    filter_kruskal_recurse(edge_list.data(), edge_list.size(), set, result,
+                           node_count, thread_count, buffer, urbg);
+
+    return result;
+}
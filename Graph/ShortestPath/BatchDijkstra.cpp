@@ -0,0 +1,225 @@
+/*
+ * name: 多源批量最短路
+ * description:
+ *
+ * batch_dijkstra()：对一组源点分别求单源最短路，结果按行优先写入调用者提供的矩阵
+ * （第 i 行为 sources[i] 到各节点的距离）。多个线程各自持有一个 DijkstraWorkspace，
+ * 通过原子计数器领取下一个源点；距离直接写入矩阵中对应的行，堆的内存在各次计算之间复用，不再反复分配。
+ *
+ * multi_source_dijkstra()：把所有种子同时以距离 0 放入堆中跑一次 Dijkstra，
+ * 得到每个节点到最近种子的距离以及该种子的编号（例如求每个点到最近设施的距离）。
+ *
+ * 边权必须非负。编译时需要加 -pthread。
+ *
+ * 时间复杂度：batch_dijkstra() $O(K M \log{M} / T)$，multi_source_dijkstra() $O(M \log{M})$，K 为源点数，T 为线程数
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define MY_INFINITY (1LL << 60)
+
+typedef long long i64;
+
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+struct NodeInfo {
+    size_t node;
+    i64 distance;
+
+    friend bool operator<(NodeInfo const &left, NodeInfo const &right) {
+        return left.distance > right.distance;
+    }
+
+    explicit constexpr NodeInfo(size_t node_, i64 distance_)
+        : node{node_}, distance{distance_} {}
+};
+
+// 每个线程一份，在多次计算之间复用
+struct DijkstraWorkspace {
+    // 以 NodeInfo::operator< 建堆，堆顶为距离最小的节点
+    std::vector<NodeInfo> heap;
+};
+
+// 结果写入 distance[0, node_count)
+// 堆中元素的距离大于 distance[node] 即为过期元素，因此不需要 visited 数组
+void dijkstra_into(CSRGraph const &graph, size_t source_node, i64 *distance,
+                   DijkstraWorkspace &workspace) {
+    std::vector<NodeInfo> &heap = workspace.heap;
+
+    std::fill(distance, distance + graph.node_count(), MY_INFINITY);
+    heap.clear();
+
+    distance[source_node] = 0;
+    heap.emplace_back(source_node, 0);
+
+    while (!heap.empty()) {
+        std::pop_heap(std::begin(heap), std::end(heap));
+        NodeInfo top = heap.back();
+        heap.pop_back();
+
+        if (top.distance > distance[top.node]) {
+            continue;
+        }
+
+        for (size_t i = graph.offset[top.node]; i < graph.offset[top.node + 1];
+             i++) {
+            size_t other_node = graph.target[i];
+            i64 new_distance = top.distance + graph.weight[i];
+
+            if (new_distance < distance[other_node]) {
+                distance[other_node] = new_distance;
+                heap.emplace_back(other_node, new_distance);
+                std::push_heap(std::begin(heap), std::end(heap));
+            }
+        }
+    }
+}
+
+// matrix 至少有 sources.size() * graph.node_count() 个元素
+void batch_dijkstra(CSRGraph const &graph, std::vector<size_t> const &sources,
+                    i64 *matrix, size_t thread_count) {
+    size_t node_count = graph.node_count();
+
+    thread_count = std::max<size_t>(1, std::min(thread_count, sources.size()));
+
+    std::atomic<size_t> next_source{0};
+
+    auto worker = [&]() {
+        DijkstraWorkspace workspace;
+
+        while (true) {
+            size_t i = next_source.fetch_add(1, std::memory_order_relaxed);
+
+            if (i >= sources.size()) {
+                break;
+            }
+
+            dijkstra_into(graph, sources[i], matrix + i * node_count,
+                          workspace);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+    for (size_t t = 1; t < thread_count; t++) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+struct MultiSourceResult {
+    std::vector<i64> distance;
+    // 最近种子在 seeds 中的下标，不可达时为 seeds.size()
+    std::vector<size_t> nearest_seed;
+};
+
+MultiSourceResult multi_source_dijkstra(CSRGraph const &graph,
+                                        std::vector<size_t> const &seeds) {
+    size_t node_count = graph.node_count();
+
+    std::vector<i64> distance;
+    std::vector<size_t> nearest_seed;
+
+    distance.resize(node_count, MY_INFINITY);
+    nearest_seed.resize(node_count, seeds.size());
+
+    std::vector<NodeInfo> heap;
+
+    for (size_t i = 0; i < seeds.size(); i++) {
+        if (distance[seeds[i]] != 0) {
+            distance[seeds[i]] = 0;
+            nearest_seed[seeds[i]] = i;
+            heap.emplace_back(seeds[i], 0);
+        }
+    }
+
+    std::make_heap(std::begin(heap), std::end(heap));
+
+    while (!heap.empty()) {
+        std::pop_heap(std::begin(heap), std::end(heap));
+        NodeInfo top = heap.back();
+        heap.pop_back();
+
+        if (top.distance > distance[top.node]) {
+            continue;
+        }
+
+        for (size_t i = graph.offset[top.node]; i < graph.offset[top.node + 1];
+             i++) {
+            size_t other_node = graph.target[i];
+            i64 new_distance = top.distance + graph.weight[i];
+
+            if (new_distance < distance[other_node]) {
+                distance[other_node] = new_distance;
+                nearest_seed[other_node] = nearest_seed[top.node];
+                heap.emplace_back(other_node, new_distance);
+                std::push_heap(std::begin(heap), std::end(heap));
+            }
+        }
+    }
+
+    return {distance, nearest_seed};
+}
@@ -9,13 +9,19 @@
  *
  * 因此如果需要判断整个图上是否存在负环，最严谨的做法是建立一个超级源点，向图上每个节点连一条权值为 0 的边，然后以超级源点为起点执行 Bellman–Ford 算法。
  *
+ * 若某一轮没有发生任何松弛，则可以提前结束，此时也说明从 [S] 点出发不能抵达负环。
+ *
  * 时间复杂度：$O(MN)$
  *
+ * 对于大图，可以先用 build_csr() 转为 CSRGraph 再调用 BF()，每一轮松弛都是对三个连续数组的顺序扫描
+ *
  * Verdict:
  * - C4 G
  * - https://www.luogu.com.cn/record/194504643
  */
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #define MY_INFINITY (1LL << 61)
@@ -30,6 +36,83 @@ struct Edge {
         : to{to_}, weight{weight_} {};
 };
 
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 由邻接表构建 CSR
+CSRGraph build_csr(std::vector<std::vector<Edge>> const &node_to_edges) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_to_edges.size() + 1, 0);
+
+    for (size_t i = 0; i < node_to_edges.size(); i++) {
+        graph.offset[i + 1] = graph.offset[i] + node_to_edges[i].size();
+    }
+
+    graph.target.reserve(graph.offset.back());
+    graph.weight.reserve(graph.offset.back());
+
+    for (std::vector<Edge> const &out_list : node_to_edges) {
+        for (Edge const &edge : out_list) {
+            graph.target.push_back((uint32_t)edge.to);
+            graph.weight.push_back(edge.weight);
+        }
+    }
+
+    return graph;
+}
+
 struct BFResult {
     bool valid;
     std::vector<i64> shortest_distance;
@@ -47,6 +130,8 @@ BFResult BF(std::vector<std::vector<Edge>> const &graph, size_t source_node) {
     shortest_distance[source_node] = 0;
 
     for (size_t i = 0; i < graph.size() - 1; i++) {
+        bool changed = false;
+
         for (size_t from_node = 1; from_node < graph.size(); from_node++) {
             for (Edge const &edge : graph[from_node]) {
                 size_t to_node = edge.to;
@@ -56,9 +141,15 @@ BFResult BF(std::vector<std::vector<Edge>> const &graph, size_t source_node) {
                     shortest_distance[to_node] =
                         shortest_distance[from_node] + edge.weight;
                     parent[to_node] = from_node;
+                    changed = true;
                 }
             }
         }
+
+        // 本轮没有任何松弛，之后也不会有，且不存在负环
+        if (!changed) {
+            return {valid, shortest_distance, parent};
+        }
     }
 
     for (size_t from_node = 1; from_node < graph.size(); from_node++) {
@@ -77,3 +168,63 @@ BFResult BF(std::vector<std::vector<Edge>> const &graph, size_t source_node) {
 
     return {valid, shortest_distance, parent};
 }
+
+// 节点编号任意（可以从 0 开始），不可达节点的距离保持为 MY_INFINITY
+BFResult BF(CSRGraph const &graph, size_t source_node) {
+    size_t node_count = graph.node_count();
+
+    bool valid = true;
+    std::vector<i64> shortest_distance;
+    std::vector<size_t> parent;
+
+    shortest_distance.resize(node_count, MY_INFINITY);
+    parent.resize(node_count, 0);
+
+    shortest_distance[source_node] = 0;
+
+    for (size_t i = 0; i + 1 < node_count; i++) {
+        bool changed = false;
+
+        for (size_t from_node = 0; from_node < node_count; from_node++) {
+            i64 from_distance = shortest_distance[from_node];
+
+            if (from_distance == MY_INFINITY) {
+                continue;
+            }
+
+            for (size_t j = graph.offset[from_node];
+                 j < graph.offset[from_node + 1]; j++) {
+                size_t to_node = graph.target[j];
+
+                if (from_distance + graph.weight[j] <
+                    shortest_distance[to_node]) {
+                    shortest_distance[to_node] =
+                        from_distance + graph.weight[j];
+                    parent[to_node] = from_node;
+                    changed = true;
+                }
+            }
+        }
+
+        if (!changed) {
+            return {valid, shortest_distance, parent};
+        }
+    }
+
+    for (size_t from_node = 0; from_node < node_count && valid; from_node++) {
+        if (shortest_distance[from_node] == MY_INFINITY) {
+            continue;
+        }
+
+        for (size_t j = graph.offset[from_node];
+             j < graph.offset[from_node + 1]; j++) {
+            if (shortest_distance[from_node] + graph.weight[j] <
+                shortest_distance[graph.target[j]]) {
+                valid = false;
+                break;
+            }
+        }
+    }
+
+    return {valid, shortest_distance, parent};
+}
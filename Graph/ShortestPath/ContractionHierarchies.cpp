@@ -0,0 +1,674 @@
+/*
+ * name: 收缩层次（Contraction Hierarchies）
+ * description:
+ *
+ * 适用于静态图上大量点对点最短路询问。预处理时按某种顺序逐个“收缩”节点：
+ * 删除节点 v 时，对每对入邻居 u、出邻居 w，若不存在绕开 v 且不长于 $d(u, v) + d(v, w)$ 的路径（见证路径），
+ * 就加入捷径 $u \to w$。记节点被收缩的次序为其等级（rank）。
+ *
+ * - 收缩次序：按 2 * 边差（需加入的捷径数 - 删除的边数）+ 已收缩的邻居数 从小到大，用懒更新的堆维护
+ * - 见证搜索：从 u 出发、不经过 v 的受限 Dijkstra，超过距离上限或访问节点数上限即停止（多加捷径不影响正确性）
+ *
+ * 询问时，只需从 s 沿等级升高的边正向搜索、从 t 沿等级升高的边反向搜索，两侧搜索空间都很小。
+ * 搜索时若某个节点能经由等级更高的已访问节点以更短的距离到达，则它不在最短路上，不必扩展（stall-on-demand）。
+ *
+ * 预处理结果 CHIndex 可以用 save() 写成紧凑的二进制文件。文件头之后依次为各 u64 / i64 数组和 u32 数组，
+ * 均自然对齐，因此 MappedCHIndex 可以直接 mmap 该文件作为索引使用，服务重启时无需重新预处理。
+ *
+ * 边权必须非负，要求节点数小于 2^32；mmap 部分依赖 POSIX。
+ *
+ * 时间复杂度：预处理视图的结构而定；单次询问在道路网上通常只访问数百个节点
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MY_INFINITY (1LL << 60)
+
+// 见证搜索最多确定的节点数
+#define WITNESS_SETTLE_LIMIT 500
+
+// 索引文件头的魔数 "CHIX"
+#define CH_INDEX_MAGIC 0x58494843ULL
+#define CH_INDEX_VERSION 1ULL
+
+typedef long long i64;
+
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+struct NodeInfo {
+    size_t node;
+    i64 distance;
+
+    friend bool operator<(NodeInfo const &left, NodeInfo const &right) {
+        return left.distance > right.distance;
+    }
+
+    explicit constexpr NodeInfo(size_t node_, i64 distance_)
+        : node{node_}, distance{distance_} {}
+};
+
+// 询问只需要的数据：正向图只含指向更高等级的边，
+// 反向图中 v 的边 (v, u) 表示原图（含捷径）中等级更高的 u 到 v 的边
+struct CHIndexView {
+    size_t node_count;
+    uint64_t const *forward_offset;
+    uint64_t const *backward_offset;
+    i64 const *forward_weight;
+    i64 const *backward_weight;
+    uint32_t const *forward_target;
+    uint32_t const *backward_target;
+};
+
+struct CHIndex {
+    std::vector<uint64_t> forward_offset;
+    std::vector<uint64_t> backward_offset;
+    std::vector<i64> forward_weight;
+    std::vector<i64> backward_weight;
+    std::vector<uint32_t> forward_target;
+    std::vector<uint32_t> backward_target;
+
+    CHIndexView view() const {
+        return {forward_offset.size() - 1, forward_offset.data(),
+                backward_offset.data(),    forward_weight.data(),
+                backward_weight.data(),    forward_target.data(),
+                backward_target.data()};
+    }
+
+    // 文件格式：magic, version, node_count, forward_edge_count,
+    // backward_edge_count（均为 u64），随后依次为 forward_offset,
+    // backward_offset, forward_weight, backward_weight, forward_target,
+    // backward_target
+    bool save(char const *path) const {
+        FILE *file = std::fopen(path, "wb");
+
+        if (file == nullptr) {
+            return false;
+        }
+
+        uint64_t header[5] = {CH_INDEX_MAGIC, CH_INDEX_VERSION,
+                              forward_offset.size() - 1, forward_target.size(),
+                              backward_target.size()};
+
+        bool ok = std::fwrite(header, sizeof(header), 1, file) == 1;
+
+        ok = ok && write_array(file, forward_offset);
+        ok = ok && write_array(file, backward_offset);
+        ok = ok && write_array(file, forward_weight);
+        ok = ok && write_array(file, backward_weight);
+        ok = ok && write_array(file, forward_target);
+        ok = ok && write_array(file, backward_target);
+
+        return std::fclose(file) == 0 && ok;
+    }
+
+  private:
+    template <typename T>
+    static bool write_array(FILE *file, std::vector<T> const &array) {
+        return array.empty() ||
+               std::fwrite(array.data(), sizeof(T), array.size(), file) ==
+                   array.size();
+    }
+};
+
+// 以只读方式 mmap 索引文件，valid() 为 false 表示打开失败或格式不符
+class MappedCHIndex {
+  public:
+    explicit MappedCHIndex(char const *path) : data{nullptr}, length{0} {
+        int fd = open(path, O_RDONLY);
+
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat file_stat;
+
+        if (fstat(fd, &file_stat) == 0 &&
+            (size_t)file_stat.st_size >= 5 * sizeof(uint64_t)) {
+            length = (size_t)file_stat.st_size;
+            data = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+
+            if (data == MAP_FAILED) {
+                data = nullptr;
+            }
+        }
+
+        close(fd);
+
+        if (data != nullptr && !parse()) {
+            munmap(data, length);
+            data = nullptr;
+        }
+    }
+
+    MappedCHIndex(MappedCHIndex const &) = delete;
+    MappedCHIndex &operator=(MappedCHIndex const &) = delete;
+
+    ~MappedCHIndex() {
+        if (data != nullptr) {
+            munmap(data, length);
+        }
+    }
+
+    bool valid() const { return data != nullptr; }
+
+    CHIndexView view() const { return index_view; }
+
+  private:
+    void *data;
+    size_t length;
+    CHIndexView index_view;
+
+    bool parse() {
+        uint64_t const *header = (uint64_t const *)data;
+
+        if (header[0] != CH_INDEX_MAGIC || header[1] != CH_INDEX_VERSION) {
+            return false;
+        }
+
+        size_t n = header[2];
+        size_t forward_count = header[3];
+        size_t backward_count = header[4];
+
+        size_t expected = 5 * sizeof(uint64_t) +
+                          2 * (n + 1) * sizeof(uint64_t) +
+                          (forward_count + backward_count) *
+                              (sizeof(i64) + sizeof(uint32_t));
+
+        if (length != expected) {
+            return false;
+        }
+
+        char const *cursor = (char const *)data + 5 * sizeof(uint64_t);
+
+        index_view.node_count = n;
+        index_view.forward_offset = (uint64_t const *)cursor;
+        cursor += (n + 1) * sizeof(uint64_t);
+        index_view.backward_offset = (uint64_t const *)cursor;
+        cursor += (n + 1) * sizeof(uint64_t);
+        index_view.forward_weight = (i64 const *)cursor;
+        cursor += forward_count * sizeof(i64);
+        index_view.backward_weight = (i64 const *)cursor;
+        cursor += backward_count * sizeof(i64);
+        index_view.forward_target = (uint32_t const *)cursor;
+        cursor += forward_count * sizeof(uint32_t);
+        index_view.backward_target = (uint32_t const *)cursor;
+
+        return true;
+    }
+};
+
+class CHBuilder {
+  public:
+    explicit CHBuilder(CSRGraph const &graph)
+        : node_count{graph.node_count()}, witness_round{0} {
+        out_arcs.resize(node_count);
+        in_arcs.resize(node_count);
+        rank.resize(node_count, 0);
+        contracted.resize(node_count, 0);
+        contracted_neighbors.resize(node_count, 0);
+        witness_distance.resize(node_count, MY_INFINITY);
+        witness_stamp.resize(node_count, 0);
+        witness_target.resize(node_count, 0);
+
+        for (size_t u = 0; u < node_count; u++) {
+            for (size_t i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+                if (graph.target[i] != u) {
+                    add_arc(u, graph.target[i], graph.weight[i]);
+                }
+            }
+        }
+    }
+
+    CHIndex build() {
+        using Item = std::pair<i64, uint32_t>;
+
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>>
+            order_queue;
+
+        for (size_t v = 0; v < node_count; v++) {
+            order_queue.emplace(priority(v), (uint32_t)v);
+        }
+
+        uint32_t next_rank = 0;
+
+        while (!order_queue.empty()) {
+            size_t v = order_queue.top().second;
+            order_queue.pop();
+
+            if (contracted[v] != 0) {
+                continue;
+            }
+
+            // 懒更新：重新计算的优先级若不再是最小的，就放回堆中
+            i64 current_priority = priority(v);
+
+            if (!order_queue.empty() &&
+                current_priority > order_queue.top().first) {
+                order_queue.emplace(current_priority, (uint32_t)v);
+                continue;
+            }
+
+            contract(v, false);
+
+            contracted[v] = 1;
+            rank[v] = next_rank++;
+
+            // 从邻居的边表中删去 v，v 自己的边表保留下来，其中都是等级更高的节点
+            for (Arc const &arc : out_arcs[v]) {
+                contracted_neighbors[arc.node]++;
+                remove_arc(in_arcs[arc.node], v);
+            }
+            for (Arc const &arc : in_arcs[v]) {
+                contracted_neighbors[arc.node]++;
+                remove_arc(out_arcs[arc.node], v);
+            }
+        }
+
+        CHIndex index;
+
+        index.forward_offset.resize(node_count + 1, 0);
+        index.backward_offset.resize(node_count + 1, 0);
+
+        for (size_t v = 0; v < node_count; v++) {
+            for (Arc const &arc : out_arcs[v]) {
+                if (rank[arc.node] > rank[v]) {
+                    index.forward_target.push_back(arc.node);
+                    index.forward_weight.push_back(arc.weight);
+                }
+            }
+
+            for (Arc const &arc : in_arcs[v]) {
+                if (rank[arc.node] > rank[v]) {
+                    index.backward_target.push_back(arc.node);
+                    index.backward_weight.push_back(arc.weight);
+                }
+            }
+
+            index.forward_offset[v + 1] = index.forward_target.size();
+            index.backward_offset[v + 1] = index.backward_target.size();
+        }
+
+        return index;
+    }
+
+  private:
+    struct Arc {
+        uint32_t node;
+        i64 weight;
+    };
+
+    size_t node_count;
+    std::vector<std::vector<Arc>> out_arcs;
+    std::vector<std::vector<Arc>> in_arcs;
+
+    std::vector<uint32_t> rank;
+    std::vector<int> contracted;
+    std::vector<i64> contracted_neighbors;
+
+    // 见证搜索的状态，用时间戳懒惰重置
+    std::vector<i64> witness_distance;
+    std::vector<uint32_t> witness_stamp;
+    std::vector<uint32_t> witness_target;
+    uint32_t witness_round;
+    std::vector<NodeInfo> witness_heap;
+
+    // 加入边 u -> w，已有该边时保留较小的权值
+    void add_arc(size_t u, size_t w, i64 weight) {
+        for (Arc &arc : out_arcs[u]) {
+            if (arc.node == w) {
+                if (arc.weight <= weight) {
+                    return;
+                }
+
+                arc.weight = weight;
+
+                for (Arc &reverse_arc : in_arcs[w]) {
+                    if (reverse_arc.node == u) {
+                        reverse_arc.weight = weight;
+                    }
+                }
+
+                return;
+            }
+        }
+
+        out_arcs[u].push_back({(uint32_t)w, weight});
+        in_arcs[w].push_back({(uint32_t)u, weight});
+    }
+
+    static void remove_arc(std::vector<Arc> &arc_list, size_t node) {
+        for (size_t i = 0; i < arc_list.size(); i++) {
+            if (arc_list[i].node == node) {
+                arc_list[i] = arc_list.back();
+                arc_list.pop_back();
+                return;
+            }
+        }
+    }
+
+    i64 priority(size_t v) {
+        i64 removed = 0;
+
+        for (Arc const &arc : out_arcs[v]) {
+            removed += contracted[arc.node] == 0 ? 1 : 0;
+        }
+        for (Arc const &arc : in_arcs[v]) {
+            removed += contracted[arc.node] == 0 ? 1 : 0;
+        }
+
+        i64 shortcuts = (i64)contract(v, true);
+
+        return 2 * (shortcuts - removed) + contracted_neighbors[v];
+    }
+
+    // 收缩 v，simulate 为 true 时只统计需要的捷径数
+    size_t contract(size_t v, bool simulate) {
+        size_t shortcut_count = 0;
+
+        for (Arc const &in_arc : in_arcs[v]) {
+            size_t u = in_arc.node;
+
+            if (contracted[u] != 0) {
+                continue;
+            }
+
+            next_witness_round();
+
+            i64 limit = 0;
+            size_t target_count = 0;
+
+            for (Arc const &out_arc : out_arcs[v]) {
+                if (contracted[out_arc.node] == 0 && out_arc.node != u) {
+                    limit = std::max(limit, in_arc.weight + out_arc.weight);
+
+                    if (witness_target[out_arc.node] != witness_round) {
+                        witness_target[out_arc.node] = witness_round;
+                        target_count++;
+                    }
+                }
+            }
+
+            if (target_count == 0) {
+                continue;
+            }
+
+            witness_search(u, v, limit, target_count);
+
+            for (Arc const &out_arc : out_arcs[v]) {
+                size_t w = out_arc.node;
+
+                if (contracted[w] != 0 || w == u) {
+                    continue;
+                }
+
+                i64 via = in_arc.weight + out_arc.weight;
+
+                if (witness_stamp[w] == witness_round &&
+                    witness_distance[w] <= via) {
+                    continue;
+                }
+
+                shortcut_count++;
+
+                if (!simulate) {
+                    add_arc(u, w, via);
+                }
+            }
+        }
+
+        return shortcut_count;
+    }
+
+    void next_witness_round() {
+        witness_round++;
+
+        if (witness_round == 0) {
+            std::fill(std::begin(witness_stamp), std::end(witness_stamp), 0);
+            std::fill(std::begin(witness_target), std::end(witness_target), 0);
+            witness_round = 1;
+        }
+    }
+
+    // 从 source 出发、不经过 excluded 和已收缩节点的受限 Dijkstra，
+    // 所有 witness_target 标记的节点都已确定时提前结束
+    void witness_search(size_t source, size_t excluded, i64 limit,
+                        size_t target_count) {
+        witness_heap.clear();
+
+        witness_stamp[source] = witness_round;
+        witness_distance[source] = 0;
+        witness_heap.emplace_back(source, 0);
+
+        size_t settled = 0;
+
+        while (!witness_heap.empty() && settled < WITNESS_SETTLE_LIMIT) {
+            std::pop_heap(std::begin(witness_heap), std::end(witness_heap));
+            NodeInfo top = witness_heap.back();
+            witness_heap.pop_back();
+
+            if (top.distance != witness_distance[top.node]) {
+                continue;
+            }
+
+            if (top.distance > limit) {
+                break;
+            }
+
+            settled++;
+
+            if (witness_target[top.node] == witness_round) {
+                target_count--;
+
+                if (target_count == 0) {
+                    break;
+                }
+            }
+
+            for (Arc const &arc : out_arcs[top.node]) {
+                size_t w = arc.node;
+
+                if (w == excluded || contracted[w] != 0) {
+                    continue;
+                }
+
+                i64 new_distance = top.distance + arc.weight;
+
+                if (witness_stamp[w] != witness_round ||
+                    new_distance < witness_distance[w]) {
+                    witness_stamp[w] = witness_round;
+                    witness_distance[w] = new_distance;
+                    witness_heap.emplace_back(w, new_distance);
+                    std::push_heap(std::begin(witness_heap),
+                                   std::end(witness_heap));
+                }
+            }
+        }
+    }
+};
+
+// 询问对象持有可复用的状态，多个线程应各自使用一个 CHQuery
+class CHQuery {
+  public:
+    explicit CHQuery(CHIndexView index_) : index{index_}, round{0} {
+        forward.distance.resize(index.node_count, MY_INFINITY);
+        forward.touched.resize(index.node_count, 0);
+        backward.distance.resize(index.node_count, MY_INFINITY);
+        backward.touched.resize(index.node_count, 0);
+    }
+
+    // 不可达时返回 MY_INFINITY
+    i64 distance(size_t source_node, size_t target_node) {
+        round++;
+
+        if (round == 0) {
+            std::fill(std::begin(forward.touched), std::end(forward.touched),
+                      0);
+            std::fill(std::begin(backward.touched),
+                      std::end(backward.touched), 0);
+            round = 1;
+        }
+
+        forward.heap.clear();
+        backward.heap.clear();
+
+        relax(forward, source_node, 0);
+        relax(backward, target_node, 0);
+
+        i64 best = MY_INFINITY;
+
+        while (!forward.heap.empty() || !backward.heap.empty()) {
+            bool is_forward =
+                backward.heap.empty() ||
+                (!forward.heap.empty() && forward.heap.front().distance <=
+                                              backward.heap.front().distance);
+
+            SearchState &state = is_forward ? forward : backward;
+            SearchState &other = is_forward ? backward : forward;
+
+            // 该方向上不会再找到更短的路径
+            if (state.heap.front().distance >= best) {
+                state.heap.clear();
+                continue;
+            }
+
+            std::pop_heap(std::begin(state.heap), std::end(state.heap));
+            NodeInfo top = state.heap.back();
+            state.heap.pop_back();
+
+            if (top.distance != state.distance[top.node]) {
+                continue;
+            }
+
+            if (other.touched[top.node] == round) {
+                best = std::min(best, top.distance + other.distance[top.node]);
+            }
+
+            uint64_t const *offset =
+                is_forward ? index.forward_offset : index.backward_offset;
+            uint32_t const *target =
+                is_forward ? index.forward_target : index.backward_target;
+            i64 const *weight =
+                is_forward ? index.forward_weight : index.backward_weight;
+
+            // 反方向的边指向等级更高的节点，用于 stall-on-demand
+            uint64_t const *stall_offset =
+                is_forward ? index.backward_offset : index.forward_offset;
+            uint32_t const *stall_target =
+                is_forward ? index.backward_target : index.forward_target;
+            i64 const *stall_weight =
+                is_forward ? index.backward_weight : index.forward_weight;
+
+            bool stalled = false;
+
+            for (uint64_t i = stall_offset[top.node];
+                 i < stall_offset[top.node + 1]; i++) {
+                size_t x = stall_target[i];
+
+                if (state.touched[x] == round &&
+                    state.distance[x] + stall_weight[i] < top.distance) {
+                    stalled = true;
+                    break;
+                }
+            }
+
+            if (stalled) {
+                continue;
+            }
+
+            for (uint64_t i = offset[top.node]; i < offset[top.node + 1];
+                 i++) {
+                relax(state, target[i], top.distance + weight[i]);
+            }
+        }
+
+        return best;
+    }
+
+  private:
+    struct SearchState {
+        std::vector<i64> distance;
+        std::vector<uint32_t> touched;
+        std::vector<NodeInfo> heap;
+    };
+
+    CHIndexView index;
+    uint32_t round;
+    SearchState forward;
+    SearchState backward;
+
+    void relax(SearchState &state, size_t node, i64 distance) {
+        if (state.touched[node] == round && state.distance[node] <= distance) {
+            return;
+        }
+
+        state.touched[node] = round;
+        state.distance[node] = distance;
+        state.heap.emplace_back(node, distance);
+        std::push_heap(std::begin(state.heap), std::end(state.heap));
+    }
+};
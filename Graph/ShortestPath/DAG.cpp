@@ -1,11 +1,21 @@
 // 警告：暂时未经验证！
 // 其中，拓扑排序部分已经验证
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
 #define MY_INFINITY (1LL << 61)
 
+// 元素少于该值时直接在当前线程执行
+#define PARALLEL_GRAIN 4096
+
 typedef long long i64;
 
 struct Edge {
@@ -16,6 +26,83 @@ struct Edge {
         : to{to_}, weight{weight_} {};
 };
 
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 由邻接表构建 CSR
+CSRGraph build_csr(std::vector<std::vector<Edge>> const &node_to_edges) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_to_edges.size() + 1, 0);
+
+    for (size_t i = 0; i < node_to_edges.size(); i++) {
+        graph.offset[i + 1] = graph.offset[i] + node_to_edges[i].size();
+    }
+
+    graph.target.reserve(graph.offset.back());
+    graph.weight.reserve(graph.offset.back());
+
+    for (std::vector<Edge> const &out_list : node_to_edges) {
+        for (Edge const &edge : out_list) {
+            graph.target.push_back((uint32_t)edge.to);
+            graph.weight.push_back(edge.weight);
+        }
+    }
+
+    return graph;
+}
+
 struct TopoResult {
     int result_code;
     std::vector<size_t> result;
@@ -29,6 +116,8 @@ struct DistanceResult {
 TopoResult topo_sort(std::vector<std::vector<Edge>> const &graph);
 DistanceResult DAGShortestPath(std::vector<std::vector<Edge>> const &graph,
                                size_t source_node);
+TopoResult topo_sort(CSRGraph const &graph);
+DistanceResult DAGShortestPath(CSRGraph const &graph, size_t source_node);
 
 // Sorted sequence cannot be
 // determined，表示拓扑排序不唯一（条件：任意时刻入度为0的顶点的集合的元素个数大于1）
@@ -98,14 +187,12 @@ DistanceResult DAGShortestPath(std::vector<std::vector<Edge>> const &graph,
 
     TopoResult topo_result = topo_sort(graph);
 
-    std::vector<size_t> topo_list = topo_result.result;
-
     distance.resize(graph.size(), MY_INFINITY);
     parent.resize(graph.size(), 0);
 
     distance[source_node] = 0;
 
-    for (size_t from_node : topo_list) {
+    for (size_t from_node : topo_result.result) {
         for (Edge const &edge : graph[from_node]) {
             size_t to_node = edge.to;
 
@@ -117,4 +204,504 @@ DistanceResult DAGShortestPath(std::vector<std::vector<Edge>> const &graph,
     }
 
     return {distance, parent};
-}
\ No newline at end of file
+}
+
+TopoResult topo_sort(CSRGraph const &graph) {
+    size_t node_count = graph.node_count();
+
+    int result_code = 0;
+    std::vector<size_t> result;
+    result.reserve(node_count);
+
+    std::vector<size_t> in_count;
+    in_count.resize(node_count, 0);
+
+    for (uint32_t to_node : graph.target) {
+        in_count[to_node]++;
+    }
+
+    std::queue<size_t> node_queue;
+
+    for (size_t i = 0; i < node_count; i++) {
+        if (in_count[i] == 0) {
+            node_queue.push(i);
+        }
+    }
+
+    while (!node_queue.empty()) {
+        if (node_queue.size() > 1) {
+            result_code = 2;
+        }
+        size_t current_node = node_queue.front();
+        node_queue.pop();
+
+        result.push_back(current_node);
+
+        for (size_t i = graph.offset[current_node];
+             i < graph.offset[current_node + 1]; i++) {
+            size_t other_node = graph.target[i];
+
+            if (in_count[other_node] == 1) {
+                node_queue.push(other_node);
+            }
+
+            in_count[other_node]--;
+        }
+    }
+
+    if (result.size() < node_count) {
+        result_code = 1;
+    }
+
+    return {result_code, result};
+}
+
+DistanceResult DAGShortestPath(CSRGraph const &graph, size_t source_node) {
+    std::vector<i64> distance;
+    std::vector<size_t> parent;
+
+    TopoResult topo_result = topo_sort(graph);
+
+    distance.resize(graph.node_count(), MY_INFINITY);
+    parent.resize(graph.node_count(), 0);
+
+    distance[source_node] = 0;
+
+    for (size_t from_node : topo_result.result) {
+        i64 from_distance = distance[from_node];
+
+        if (from_distance == MY_INFINITY) {
+            continue;
+        }
+
+        for (size_t i = graph.offset[from_node];
+             i < graph.offset[from_node + 1]; i++) {
+            size_t to_node = graph.target[i];
+
+            if (from_distance + graph.weight[i] < distance[to_node]) {
+                distance[to_node] = from_distance + graph.weight[i];
+                parent[to_node] = from_node;
+            }
+        }
+    }
+
+    return {distance, parent};
+}
+
+// 按层并行（编译时需要加 -pthread）
+//
+// Kahn 算法按层进行：第 0 层为入度为 0 的节点，第 k 层为删去前 k 层后入度变为 0 的节点。
+// 同一层的节点之间没有边，因此一层内的节点可以并行处理，层与层之间同步。
+// 工作线程在每次调用开始时创建一次（WorkerPool），各层只唤醒它们并等待完成，不再重复创建线程。
+// 各层都以“拉取”的方式计算：节点 v 遍历反图上的入边读取前面各层已经确定的值，只写自己的位置，不需要原子操作。
+//
+// critical_path() 求最长路（关键路径）：earliest[v] 为 v 的最早开始时间（从任意入度为 0 的节点出发的最长路），
+// latest[v] 为不推迟整体完成时间的前提下 v 的最晚开始时间，slack[v] = latest[v] - earliest[v]，
+// 松弛为 0 的节点即关键节点。边权（耗时）应非负。若任务的耗时记在节点上，可以把耗时加到该节点的每条出边上，
+// 汇点的耗时则通过连向一个虚拟终点的边表示。
+
+// 常驻的工作线程：构造时创建 thread_count - 1 个线程，之后每次 parallel_for() 只唤醒它们，
+// 由当前线程执行第 0 段，各段都完成后返回。相邻两轮之间经过互斥锁同步，上一轮的写入对下一轮可见
+class WorkerPool {
+  public:
+    explicit WorkerPool(size_t thread_count_)
+        : thread_count{std::max<size_t>(thread_count_, 1)}, task{nullptr},
+          invoke{nullptr}, generation{0}, running{0}, stopping{false} {
+        workers.reserve(thread_count - 1);
+
+        for (size_t t = 1; t < thread_count; t++) {
+            workers.emplace_back([this, t]() { work(t); });
+        }
+    }
+
+    WorkerPool(WorkerPool const &) = delete;
+    WorkerPool &operator=(WorkerPool const &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        start.notify_all();
+
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t size() const { return thread_count; }
+
+    // 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+    // 元素较少时直接在当前线程执行，避免唤醒线程的开销
+    template <typename Fn>
+    void parallel_for(size_t count, Fn &&fn) {
+        if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+            fn((size_t)0, (size_t)0, count);
+            return;
+        }
+
+        size_t chunk = (count + thread_count - 1) / thread_count;
+
+        auto run_chunk = [&](size_t t) {
+            size_t begin = std::min(count, t * chunk);
+            size_t end = std::min(count, begin + chunk);
+
+            fn(t, begin, end);
+        };
+
+        dispatch(&run_chunk, &call<decltype(run_chunk)>);
+    }
+
+  private:
+    size_t thread_count;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+
+    // 本轮的任务，由 invoke(task, thread_id) 执行
+    void *task;
+    void (*invoke)(void *, size_t);
+    // 已发布的轮数、本轮尚未完成的工作线程数
+    size_t generation;
+    size_t running;
+    bool stopping;
+
+    template <typename Task>
+    static void call(void *task_, size_t thread_id) {
+        (*static_cast<Task *>(task_))(thread_id);
+    }
+
+    void dispatch(void *task_, void (*invoke_)(void *, size_t)) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            task = task_;
+            invoke = invoke_;
+            running = thread_count - 1;
+            generation++;
+        }
+        start.notify_all();
+
+        invoke_(task_, 0);
+
+        std::unique_lock<std::mutex> lock{mutex};
+        done.wait(lock, [this]() { return running == 0; });
+    }
+
+    void work(size_t thread_id) {
+        size_t seen = 0;
+
+        while (true) {
+            void *current_task = nullptr;
+            void (*current_invoke)(void *, size_t) = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                start.wait(lock,
+                           [&]() { return stopping || generation != seen; });
+
+                if (stopping) {
+                    return;
+                }
+
+                seen = generation;
+                current_task = task;
+                current_invoke = invoke;
+            }
+
+            current_invoke(current_task, thread_id);
+
+            bool last = false;
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                last = --running == 0;
+            }
+
+            if (last) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+// 反图：节点 v 的出边为原图中指向 v 的边
+CSRGraph reverse_csr(CSRGraph const &graph) {
+    size_t node_count = graph.node_count();
+
+    CSRGraph reversed;
+
+    reversed.offset.resize(node_count + 1, 0);
+    reversed.target.resize(graph.target.size());
+    reversed.weight.resize(graph.weight.size());
+
+    for (uint32_t to_node : graph.target) {
+        reversed.offset[to_node + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        reversed.offset[i + 1] += reversed.offset[i];
+    }
+
+    for (size_t u = 0; u < node_count; u++) {
+        for (size_t i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+            size_t pos = reversed.offset[graph.target[i]]++;
+
+            reversed.target[pos] = (uint32_t)u;
+            reversed.weight[pos] = graph.weight[i];
+        }
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        reversed.offset[i] = reversed.offset[i - 1];
+    }
+    reversed.offset[0] = 0;
+
+    return reversed;
+}
+
+// 第 k 层的节点为 order 中下标在 [level_offset[k], level_offset[k + 1]) 内的元素
+// 图中有环时 valid 为 false，order 只包含环以外能被排出的节点
+struct DAGLevels {
+    bool valid;
+    std::vector<uint32_t> order;
+    std::vector<size_t> level_offset;
+
+    size_t level_count() const { return level_offset.size() - 1; }
+};
+
+// reversed_graph 为 reverse_csr(graph)，各节点的入度直接由其 offset 得到
+DAGLevels dag_levels(CSRGraph const &graph, CSRGraph const &reversed_graph,
+                     WorkerPool &pool) {
+    size_t node_count = graph.node_count();
+
+    std::vector<std::atomic<uint32_t>> in_count(node_count);
+
+    DAGLevels levels;
+    levels.order.reserve(node_count);
+    levels.level_offset.push_back(0);
+
+    for (size_t v = 0; v < node_count; v++) {
+        size_t degree =
+            reversed_graph.offset[v + 1] - reversed_graph.offset[v];
+
+        in_count[v].store((uint32_t)degree, std::memory_order_relaxed);
+
+        if (degree == 0) {
+            levels.order.push_back((uint32_t)v);
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> next_buffers(pool.size());
+
+    size_t level_begin = 0;
+
+    while (level_begin < levels.order.size()) {
+        size_t level_end = levels.order.size();
+        levels.level_offset.push_back(level_end);
+
+        uint32_t const *level = levels.order.data() + level_begin;
+
+        pool.parallel_for(
+            level_end - level_begin,
+            [&](size_t thread_id, size_t begin, size_t end) {
+                std::vector<uint32_t> &buffer = next_buffers[thread_id];
+
+                for (size_t k = begin; k < end; k++) {
+                    size_t u = level[k];
+
+                    for (size_t i = graph.offset[u]; i < graph.offset[u + 1];
+                         i++) {
+                        uint32_t v = graph.target[i];
+
+                        if (in_count[v].fetch_sub(
+                                1, std::memory_order_relaxed) == 1) {
+                            buffer.push_back(v);
+                        }
+                    }
+                }
+            });
+
+        for (std::vector<uint32_t> &buffer : next_buffers) {
+            levels.order.insert(std::end(levels.order), std::begin(buffer),
+                                std::end(buffer));
+            buffer.clear();
+        }
+
+        level_begin = level_end;
+    }
+
+    levels.valid = levels.order.size() == node_count;
+
+    return levels;
+}
+
+struct ParallelDistanceResult {
+    bool valid;
+    std::vector<i64> shortest_distance;
+    std::vector<size_t> parent;
+};
+
+ParallelDistanceResult parallel_DAG_shortest_path(CSRGraph const &graph,
+                                                  size_t source_node,
+                                                  size_t thread_count) {
+    size_t node_count = graph.node_count();
+
+    CSRGraph reversed_graph = reverse_csr(graph);
+    WorkerPool pool{thread_count};
+    DAGLevels levels = dag_levels(graph, reversed_graph, pool);
+
+    std::vector<i64> distance;
+    std::vector<size_t> parent;
+
+    distance.resize(node_count, MY_INFINITY);
+    parent.resize(node_count, 0);
+
+    if (!levels.valid) {
+        return {false, distance, parent};
+    }
+
+    distance[source_node] = 0;
+
+    for (size_t k = 0; k < levels.level_count(); k++) {
+        uint32_t const *level = levels.order.data() + levels.level_offset[k];
+
+        pool.parallel_for(
+            levels.level_offset[k + 1] - levels.level_offset[k],
+            [&](size_t, size_t begin, size_t end) {
+                for (size_t j = begin; j < end; j++) {
+                    size_t v = level[j];
+
+                    // 源点的前驱都不可能从源点到达，无需特判
+                    for (size_t i = reversed_graph.offset[v];
+                         i < reversed_graph.offset[v + 1]; i++) {
+                        size_t u = reversed_graph.target[i];
+
+                        if (distance[u] == MY_INFINITY) {
+                            continue;
+                        }
+
+                        if (distance[u] + reversed_graph.weight[i] <
+                            distance[v]) {
+                            distance[v] =
+                                distance[u] + reversed_graph.weight[i];
+                            parent[v] = u;
+                        }
+                    }
+                }
+            });
+    }
+
+    return {true, distance, parent};
+}
+
+struct CriticalPathResult {
+    bool valid;
+    // 整个 DAG 的完成时间，即最长路的长度
+    i64 length;
+    std::vector<i64> earliest;
+    std::vector<i64> latest;
+    std::vector<i64> slack;
+    // 一条关键路径，从某个入度为 0 的节点到 earliest 最大的节点（边权非负时出度为 0）
+    std::vector<size_t> critical_path;
+};
+
+CriticalPathResult critical_path(CSRGraph const &graph, size_t thread_count) {
+    size_t node_count = graph.node_count();
+
+    CSRGraph reversed_graph = reverse_csr(graph);
+    WorkerPool pool{thread_count};
+    DAGLevels levels = dag_levels(graph, reversed_graph, pool);
+
+    CriticalPathResult r;
+    r.valid = levels.valid;
+    r.length = 0;
+
+    if (!levels.valid || node_count == 0) {
+        return r;
+    }
+
+    std::vector<size_t> parent;
+
+    r.earliest.resize(node_count, 0);
+    r.latest.resize(node_count, 0);
+    r.slack.resize(node_count, 0);
+    parent.resize(node_count);
+
+    for (size_t v = 0; v < node_count; v++) {
+        parent[v] = v;
+    }
+
+    // 正向：按层拉取最早开始时间
+    for (size_t k = 1; k < levels.level_count(); k++) {
+        uint32_t const *level = levels.order.data() + levels.level_offset[k];
+
+        pool.parallel_for(
+            levels.level_offset[k + 1] - levels.level_offset[k],
+            [&](size_t, size_t begin, size_t end) {
+                for (size_t j = begin; j < end; j++) {
+                    size_t v = level[j];
+                    i64 best = -MY_INFINITY;
+
+                    for (size_t i = reversed_graph.offset[v];
+                         i < reversed_graph.offset[v + 1]; i++) {
+                        size_t u = reversed_graph.target[i];
+
+                        if (r.earliest[u] + reversed_graph.weight[i] > best) {
+                            best = r.earliest[u] + reversed_graph.weight[i];
+                            parent[v] = u;
+                        }
+                    }
+
+                    r.earliest[v] = best;
+                }
+            });
+    }
+
+    size_t last_node = 0;
+
+    for (size_t v = 0; v < node_count; v++) {
+        if (r.earliest[v] > r.earliest[last_node]) {
+            last_node = v;
+        }
+    }
+
+    r.length = r.earliest[last_node];
+
+    // 反向：按层逆序从出边拉取最晚开始时间，出度为 0 的节点为 length
+    for (size_t k = levels.level_count(); k > 0; k--) {
+        uint32_t const *level =
+            levels.order.data() + levels.level_offset[k - 1];
+
+        pool.parallel_for(
+            levels.level_offset[k] - levels.level_offset[k - 1],
+            [&](size_t, size_t begin, size_t end) {
+                for (size_t j = begin; j < end; j++) {
+                    size_t u = level[j];
+                    i64 best = r.length;
+
+                    for (size_t i = graph.offset[u]; i < graph.offset[u + 1];
+                         i++) {
+                        best = std::min(best, r.latest[graph.target[i]] -
+                                                  graph.weight[i]);
+                    }
+
+                    r.latest[u] = best;
+                    r.slack[u] = best - r.earliest[u];
+                }
+            });
+    }
+
+    for (size_t v = last_node;; v = parent[v]) {
+        r.critical_path.push_back(v);
+
+        if (parent[v] == v) {
+            break;
+        }
+    }
+
+    std::reverse(std::begin(r.critical_path), std::end(r.critical_path));
+
+    return r;
+}
@@ -0,0 +1,391 @@
+/*
+ * name: Delta-stepping 并行单源最短路
+ * description:
+ *
+ * 将节点按 $\lfloor d(v) / \Delta \rfloor$ 放入桶中，从编号最小的非空桶开始处理。
+ * 边权不超过 $\Delta$ 的边为轻边，其余为重边：
+ * - 轻边可能把节点放回当前桶，因此反复松弛当前桶的轻边，直到当前桶为空
+ * - 重边只会把节点放入之后的桶，因此当前桶清空后，对本桶处理过的所有节点统一松弛一次重边
+ *
+ * 节点的距离不超过当前桶的上界加最大边权，因此只需 $\lceil \text{最大边权} / \Delta \rceil + 1$ 个桶循环使用，
+ * 主循环直接跳到下一个非空桶。
+ *
+ * 同一批节点的松弛在多个线程上并行进行：距离用原子操作取最小值，
+ * 成功更新的节点先写入各线程自己的请求缓冲区，本轮结束后再统一放入对应的桶。
+ * 工作线程在每次调用开始时创建一次（WorkerPool），此后每一轮只唤醒它们并等待完成，不再重复创建线程。
+ *
+ * $\Delta = 1$ 时退化为 Dial 算法，$\Delta = \infty$ 时退化为 Bellman–Ford。
+ * 默认按 Meyer–Sanders 的建议取 $\Delta = $ 最大边权 / 平均出度。
+ *
+ * 边权必须非负，结果与 dijkstra() 完全一致。编译时需要加 -pthread。
+ *
+ * 时间复杂度：对于随机边权的图，期望$O(N + M + D \cdot L)$，其中 D 为最大出度、L 为最短路的最大长度
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#define MY_INFINITY (1LL << 60)
+
+// 元素少于该值时直接在当前线程执行
+#define PARALLEL_GRAIN 4096
+
+typedef long long i64;
+
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 常驻的工作线程：构造时创建 thread_count - 1 个线程，之后每次 parallel_for() 只唤醒它们，
+// 由当前线程执行第 0 段，各段都完成后返回。相邻两轮之间经过互斥锁同步，上一轮的写入对下一轮可见
+class WorkerPool {
+  public:
+    explicit WorkerPool(size_t thread_count_)
+        : thread_count{std::max<size_t>(thread_count_, 1)}, task{nullptr},
+          invoke{nullptr}, generation{0}, running{0}, stopping{false} {
+        workers.reserve(thread_count - 1);
+
+        for (size_t t = 1; t < thread_count; t++) {
+            workers.emplace_back([this, t]() { work(t); });
+        }
+    }
+
+    WorkerPool(WorkerPool const &) = delete;
+    WorkerPool &operator=(WorkerPool const &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        start.notify_all();
+
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t size() const { return thread_count; }
+
+    // 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+    // 元素较少时直接在当前线程执行，避免唤醒线程的开销
+    template <typename Fn>
+    void parallel_for(size_t count, Fn &&fn) {
+        if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+            fn((size_t)0, (size_t)0, count);
+            return;
+        }
+
+        size_t chunk = (count + thread_count - 1) / thread_count;
+
+        auto run_chunk = [&](size_t t) {
+            size_t begin = std::min(count, t * chunk);
+            size_t end = std::min(count, begin + chunk);
+
+            fn(t, begin, end);
+        };
+
+        dispatch(&run_chunk, &call<decltype(run_chunk)>);
+    }
+
+  private:
+    size_t thread_count;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+
+    // 本轮的任务，由 invoke(task, thread_id) 执行
+    void *task;
+    void (*invoke)(void *, size_t);
+    // 已发布的轮数、本轮尚未完成的工作线程数
+    size_t generation;
+    size_t running;
+    bool stopping;
+
+    template <typename Task>
+    static void call(void *task_, size_t thread_id) {
+        (*static_cast<Task *>(task_))(thread_id);
+    }
+
+    void dispatch(void *task_, void (*invoke_)(void *, size_t)) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            task = task_;
+            invoke = invoke_;
+            running = thread_count - 1;
+            generation++;
+        }
+        start.notify_all();
+
+        invoke_(task_, 0);
+
+        std::unique_lock<std::mutex> lock{mutex};
+        done.wait(lock, [this]() { return running == 0; });
+    }
+
+    void work(size_t thread_id) {
+        size_t seen = 0;
+
+        while (true) {
+            void *current_task = nullptr;
+            void (*current_invoke)(void *, size_t) = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                start.wait(lock,
+                           [&]() { return stopping || generation != seen; });
+
+                if (stopping) {
+                    return;
+                }
+
+                seen = generation;
+                current_task = task;
+                current_invoke = invoke;
+            }
+
+            current_invoke(current_task, thread_id);
+
+            bool last = false;
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                last = --running == 0;
+            }
+
+            if (last) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+// 原子地令 target = min(target, value)，返回是否更新
+bool atomic_min(std::atomic<i64> &target, i64 value) {
+    i64 current = target.load(std::memory_order_relaxed);
+
+    while (value < current) {
+        if (target.compare_exchange_weak(current, value,
+                                         std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// 最大边权 / 平均出度，至少为 1
+i64 choose_delta(CSRGraph const &graph) {
+    size_t edge_count = graph.target.size();
+
+    if (edge_count == 0) {
+        return 1;
+    }
+
+    i64 max_weight = *std::max_element(std::begin(graph.weight),
+                                       std::end(graph.weight));
+
+    double average_degree =
+        (double)edge_count / (double)std::max<size_t>(graph.node_count(), 1);
+
+    return std::max<i64>(1, (i64)((double)max_weight / average_degree));
+}
+
+// delta 为 0 时由 choose_delta() 决定
+std::vector<i64> delta_stepping(CSRGraph const &graph, size_t source_node,
+                                size_t thread_count, i64 delta = 0) {
+    size_t node_count = graph.node_count();
+
+    if (delta <= 0) {
+        delta = choose_delta(graph);
+    }
+
+    std::vector<std::atomic<i64>> distance(node_count);
+    for (std::atomic<i64> &d : distance) {
+        d.store(MY_INFINITY, std::memory_order_relaxed);
+    }
+
+    i64 max_weight = 0;
+    for (i64 w : graph.weight) {
+        max_weight = std::max(max_weight, w);
+    }
+
+    // 待处理的节点都在当前桶之后的 ceil(max_weight / delta) 个桶内，桶数组可以循环使用
+    size_t bucket_count = (size_t)((max_weight + delta - 1) / delta) + 1;
+
+    std::vector<std::vector<uint32_t>> buckets(bucket_count);
+    // 各桶中元素（含已失效的）的总数
+    size_t pending = 0;
+
+    auto insert = [&](size_t node, i64 d) {
+        buckets[(size_t)(d / delta) % bucket_count].push_back((uint32_t)node);
+        pending++;
+    };
+
+    // 工作线程在整个求解过程中只创建一次
+    WorkerPool pool{thread_count};
+
+    // 每个线程的请求缓冲区：(节点, 新距离)
+    std::vector<std::vector<std::pair<uint32_t, i64>>> requests(pool.size());
+
+    // 并行松弛 node_list 中节点的轻边或重边，再把成功更新的节点放入桶中
+    auto relax = [&](std::vector<uint32_t> const &node_list, bool light) {
+        pool.parallel_for(node_list.size(), [&](size_t thread_id,
+                                                size_t begin, size_t end) {
+            std::vector<std::pair<uint32_t, i64>> &buffer = requests[thread_id];
+
+            for (size_t k = begin; k < end; k++) {
+                size_t u = node_list[k];
+                i64 du = distance[u].load(std::memory_order_relaxed);
+
+                for (size_t i = graph.offset[u]; i < graph.offset[u + 1];
+                     i++) {
+                    if ((graph.weight[i] <= delta) != light) {
+                        continue;
+                    }
+
+                    size_t v = graph.target[i];
+                    i64 new_distance = du + graph.weight[i];
+
+                    if (atomic_min(distance[v], new_distance)) {
+                        buffer.emplace_back((uint32_t)v, new_distance);
+                    }
+                }
+            }
+        });
+
+        for (std::vector<std::pair<uint32_t, i64>> &buffer : requests) {
+            for (std::pair<uint32_t, i64> const &request : buffer) {
+                // 只保留最终生效的那次更新
+                if (distance[request.first].load(std::memory_order_relaxed) ==
+                    request.second) {
+                    insert(request.first, request.second);
+                }
+            }
+
+            buffer.clear();
+        }
+    };
+
+    // 用时间戳去重：frontier_stamp 标记本轮已在 frontier 中，settled_stamp 标记本桶已处理
+    std::vector<uint32_t> frontier_stamp(node_count, 0);
+    std::vector<size_t> settled_stamp(node_count, ~(size_t)0);
+    uint32_t phase = 0;
+
+    std::vector<uint32_t> frontier;
+    std::vector<uint32_t> settled;
+    std::vector<uint32_t> candidates;
+
+    distance[source_node].store(0, std::memory_order_relaxed);
+    insert(source_node, 0);
+
+    // current 为桶的绝对编号，对应 buckets[current % bucket_count]
+    for (size_t current = 0; pending > 0; current++) {
+        // 直接跳到下一个非空桶，最多跳过 bucket_count - 1 个
+        while (buckets[current % bucket_count].empty()) {
+            current++;
+        }
+
+        std::vector<uint32_t> &bucket = buckets[current % bucket_count];
+
+        settled.clear();
+
+        while (!bucket.empty()) {
+            candidates.clear();
+            candidates.swap(bucket);
+            pending -= candidates.size();
+
+            phase++;
+            frontier.clear();
+
+            for (uint32_t node : candidates) {
+                i64 d = distance[node].load(std::memory_order_relaxed);
+
+                if ((size_t)(d / delta) != current ||
+                    frontier_stamp[node] == phase) {
+                    continue;
+                }
+
+                frontier_stamp[node] = phase;
+                frontier.push_back(node);
+
+                if (settled_stamp[node] != current) {
+                    settled_stamp[node] = current;
+                    settled.push_back(node);
+                }
+            }
+
+            relax(frontier, true);
+        }
+
+        relax(settled, false);
+    }
+
+    std::vector<i64> result;
+    result.resize(node_count);
+
+    for (size_t i = 0; i < node_count; i++) {
+        result[i] = distance[i].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
@@ -8,13 +8,26 @@
  *
  * 时间复杂度：$O(M \log{M})$
  *
+ * 若权值为非负整数，可以用 dijkstra_monotone() 代替二叉堆：其优先队列只需支持单调弹出（弹出的键不减），
+ * 基数堆 RadixHeap 的复杂度为$O(M + N\log{C})$，Dial 桶队列 DialQueue 的复杂度为$O(M + NC)$（C 为最大边权，适合 C 很小的情形），
+ * 队列类型作为模板参数在编译期选定
+ *
+ * dijkstra_indexed_heap() 使用带下标的 D 叉堆，松弛时直接减小堆中已有元素的键，堆的大小始终不超过 N，也不会弹出过期元素
+ *
+ * 对于大图，可以先用 build_csr() 将边表或邻接表转为 CSRGraph 再调用 dijkstra()，遍历出边时是顺序访问。
+ * CSR 每条边占 12 字节（4 字节终点 + 8 字节边权），每个节点占 8 字节；邻接表每条边占 16 字节（不计 vector 预留的空间），
+ * 每个节点另有 24 字节的 vector 头和一次堆分配
+ *
  * Verdict：
  * - P3371: https://www.luogu.com.cn/record/194010420
  * - P4779: https://www.luogu.com.cn/record/194008908
  */
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #define MY_INFINITY (1LL << 60)
@@ -41,6 +54,83 @@ struct NodeInfo {
         : node{node_}, distance{distance_} {}
 };
 
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 由邻接表构建 CSR
+CSRGraph build_csr(std::vector<std::vector<Edge>> const &node_to_edges) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_to_edges.size() + 1, 0);
+
+    for (size_t i = 0; i < node_to_edges.size(); i++) {
+        graph.offset[i + 1] = graph.offset[i] + node_to_edges[i].size();
+    }
+
+    graph.target.reserve(graph.offset.back());
+    graph.weight.reserve(graph.offset.back());
+
+    for (std::vector<Edge> const &out_list : node_to_edges) {
+        for (Edge const &edge : out_list) {
+            graph.target.push_back((uint32_t)edge.to);
+            graph.weight.push_back(edge.weight);
+        }
+    }
+
+    return graph;
+}
+
 std::vector<i64> dijkstra(std::vector<std::vector<Edge>> const &node_to_edges,
                           size_t source_node) {
     std::vector<i64> result;
@@ -78,3 +168,312 @@ std::vector<i64> dijkstra(std::vector<std::vector<Edge>> const &node_to_edges,
 
     return result;
 }
+
+std::vector<i64> dijkstra(CSRGraph const &graph, size_t source_node) {
+    std::vector<i64> result;
+    std::vector<int> visited;
+
+    result.resize(graph.node_count(), MY_INFINITY);
+    visited.resize(graph.node_count(), 0);
+
+    std::priority_queue<NodeInfo> node_queue;
+
+    result[source_node] = 0;
+    node_queue.emplace(source_node, 0);
+
+    while (!node_queue.empty()) {
+        size_t current_node = node_queue.top().node;
+
+        node_queue.pop();
+
+        if (visited[current_node] == 1) {
+            continue;
+        }
+        visited[current_node] = 1;
+
+        i64 current_distance = result[current_node];
+
+        for (size_t i = graph.offset[current_node];
+             i < graph.offset[current_node + 1]; i++) {
+            size_t other_node = graph.target[i];
+
+            if (result[other_node] > current_distance + graph.weight[i]) {
+                result[other_node] = current_distance + graph.weight[i];
+                node_queue.emplace(other_node, result[other_node]);
+            }
+        }
+    }
+
+    return result;
+}
+
+// 基数堆，要求每次插入的键不小于最近一次弹出的键
+// 第 i 个桶存放与 last 的最高不同位为第 i - 1 位的元素，第 0 个桶存放等于 last 的元素
+class RadixHeap {
+  private:
+    std::vector<std::pair<uint64_t, uint32_t>> buckets[65];
+    uint64_t last;
+    size_t heap_size;
+
+  public:
+    explicit RadixHeap() : last{0}, heap_size{0} {}
+
+    bool empty() const { return heap_size == 0; }
+
+    void push(uint64_t key, uint32_t node) {
+        buckets[bucket_index(key)].emplace_back(key, node);
+        heap_size++;
+    }
+
+    std::pair<uint64_t, uint32_t> pop() {
+        if (buckets[0].empty()) {
+            size_t i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+
+            uint64_t new_last = buckets[i][0].first;
+            for (std::pair<uint64_t, uint32_t> const &item : buckets[i]) {
+                new_last = std::min(new_last, item.first);
+            }
+
+            last = new_last;
+
+            // 重新分配后都会落入编号更小的桶
+            for (std::pair<uint64_t, uint32_t> const &item : buckets[i]) {
+                buckets[bucket_index(item.first)].push_back(item);
+            }
+
+            buckets[i].clear();
+        }
+
+        std::pair<uint64_t, uint32_t> result = buckets[0].back();
+        buckets[0].pop_back();
+        heap_size--;
+
+        return result;
+    }
+
+  private:
+    size_t bucket_index(uint64_t key) const {
+        if (key == last) {
+            return 0;
+        }
+
+        return (size_t)(64 - __builtin_clzll(key ^ last));
+    }
+};
+
+// Dial 桶队列，要求边权不超过 max_weight
+// 队列中的键都在 [current, current + max_weight] 内，因此 max_weight + 1 个桶可以循环使用
+class DialQueue {
+  private:
+    std::vector<std::vector<std::pair<uint64_t, uint32_t>>> buckets;
+    uint64_t current;
+    size_t queue_size;
+
+  public:
+    explicit DialQueue(uint64_t max_weight) : current{0}, queue_size{0} {
+        buckets.resize(max_weight + 1);
+    }
+
+    bool empty() const { return queue_size == 0; }
+
+    void push(uint64_t key, uint32_t node) {
+        buckets[key % buckets.size()].emplace_back(key, node);
+        queue_size++;
+    }
+
+    std::pair<uint64_t, uint32_t> pop() {
+        while (buckets[current % buckets.size()].empty()) {
+            current++;
+        }
+
+        std::vector<std::pair<uint64_t, uint32_t>> &bucket =
+            buckets[current % buckets.size()];
+
+        std::pair<uint64_t, uint32_t> result = bucket.back();
+        bucket.pop_back();
+        queue_size--;
+
+        return result;
+    }
+};
+
+// 边权必须为非负整数，Queue 为 RadixHeap 或 DialQueue
+template <typename Queue>
+std::vector<i64> dijkstra_monotone(CSRGraph const &graph, size_t source_node,
+                                   Queue node_queue) {
+    std::vector<i64> result;
+    std::vector<int> visited;
+
+    result.resize(graph.node_count(), MY_INFINITY);
+    visited.resize(graph.node_count(), 0);
+
+    result[source_node] = 0;
+    node_queue.push(0, (uint32_t)source_node);
+
+    while (!node_queue.empty()) {
+        size_t current_node = node_queue.pop().second;
+
+        if (visited[current_node] == 1) {
+            continue;
+        }
+        visited[current_node] = 1;
+
+        i64 current_distance = result[current_node];
+
+        for (size_t i = graph.offset[current_node];
+             i < graph.offset[current_node + 1]; i++) {
+            size_t other_node = graph.target[i];
+
+            if (result[other_node] > current_distance + graph.weight[i]) {
+                result[other_node] = current_distance + graph.weight[i];
+                node_queue.push((uint64_t)result[other_node],
+                                (uint32_t)other_node);
+            }
+        }
+    }
+
+    return result;
+}
+
+// 带下标的 D 叉小根堆，元素为 [0, capacity) 内的编号，每个编号至多在堆中出现一次
+// position[x] 记录编号 x 在堆中的位置，从而支持 decrease_key，堆的大小不超过 capacity
+template <typename Key, size_t D = 4>
+class IndexedHeap {
+  private:
+    static constexpr size_t NOT_IN_HEAP = ~(size_t)0;
+
+    std::vector<size_t> heap;
+    std::vector<Key> key;
+    std::vector<size_t> position;
+
+  public:
+    explicit IndexedHeap(size_t capacity) {
+        heap.reserve(capacity);
+        key.resize(capacity);
+        position.resize(capacity, NOT_IN_HEAP);
+    }
+
+    bool empty() const { return heap.empty(); }
+
+    bool contains(size_t x) const { return position[x] != NOT_IN_HEAP; }
+
+    // 若 x 不在堆中则插入，否则在 new_key 更小时减小其键
+    void push_or_decrease(size_t x, Key new_key) {
+        if (!contains(x)) {
+            position[x] = heap.size();
+            heap.push_back(x);
+        } else if (!(new_key < key[x])) {
+            return;
+        }
+
+        key[x] = new_key;
+        sift_up(position[x]);
+    }
+
+    // 弹出键最小的编号
+    std::pair<size_t, Key> pop() {
+        size_t top = heap[0];
+
+        position[top] = NOT_IN_HEAP;
+
+        size_t last = heap.back();
+        heap.pop_back();
+
+        if (!heap.empty()) {
+            heap[0] = last;
+            position[last] = 0;
+            sift_down(0);
+        }
+
+        return {top, key[top]};
+    }
+
+  private:
+    void sift_up(size_t i) {
+        size_t x = heap[i];
+
+        while (i > 0) {
+            size_t p = (i - 1) / D;
+
+            if (!(key[x] < key[heap[p]])) {
+                break;
+            }
+
+            heap[i] = heap[p];
+            position[heap[i]] = i;
+            i = p;
+        }
+
+        heap[i] = x;
+        position[x] = i;
+    }
+
+    void sift_down(size_t i) {
+        size_t x = heap[i];
+
+        while (true) {
+            size_t first_child = D * i + 1;
+
+            if (first_child >= heap.size()) {
+                break;
+            }
+
+            size_t last_child = std::min(first_child + D, heap.size());
+            size_t smallest = first_child;
+
+            for (size_t c = first_child + 1; c < last_child; c++) {
+                if (key[heap[c]] < key[heap[smallest]]) {
+                    smallest = c;
+                }
+            }
+
+            if (!(key[heap[smallest]] < key[x])) {
+                break;
+            }
+
+            heap[i] = heap[smallest];
+            position[heap[i]] = i;
+            i = smallest;
+        }
+
+        heap[i] = x;
+        position[x] = i;
+    }
+};
+
+std::vector<i64> dijkstra_indexed_heap(CSRGraph const &graph,
+                                       size_t source_node) {
+    std::vector<i64> result;
+    std::vector<int> visited;
+
+    result.resize(graph.node_count(), MY_INFINITY);
+    visited.resize(graph.node_count(), 0);
+
+    IndexedHeap<i64> node_heap{graph.node_count()};
+
+    result[source_node] = 0;
+    node_heap.push_or_decrease(source_node, 0);
+
+    while (!node_heap.empty()) {
+        size_t current_node = node_heap.pop().first;
+        i64 current_distance = result[current_node];
+
+        visited[current_node] = 1;
+
+        for (size_t i = graph.offset[current_node];
+             i < graph.offset[current_node + 1]; i++) {
+            size_t other_node = graph.target[i];
+
+            if (visited[other_node] == 0 &&
+                result[other_node] > current_distance + graph.weight[i]) {
+                result[other_node] = current_distance + graph.weight[i];
+                node_heap.push_or_decrease(other_node, result[other_node]);
+            }
+        }
+    }
+
+    return result;
+}
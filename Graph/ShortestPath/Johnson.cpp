@@ -0,0 +1,241 @@
+/*
+ * name: Johnson 全源最短路
+ * description:
+ *
+ * 用于带负权边（但无负环）的稀疏图上的全源最短路，比 Floyd–Warshall 的$O(N^3)$快得多。
+ *
+ * 1. 建立一个超级源点，向每个节点连一条权值为 0 的边，从它出发跑 Bellman–Ford 得到势能 $h(v)$。
+ *    这里不真正建出超级源点：它松弛一轮后所有节点的距离都是 0，因此直接以全 0 为初值即可。
+ * 2. 将边权改为 $w'(u, v) = w(u, v) + h(u) - h(v) \ge 0$，最短路不变。
+ * 3. 从每个源点在新图上跑 Dijkstra，再令 $d(s, v) = d'(s, v) - h(s) + h(v)$。
+ *
+ * 第 3 步由多个线程并行完成，每个线程复用自己的堆与一行距离缓冲区，
+ * 每求出一行就交给调用者提供的 sink(source, row) 处理，因此完整的$N^2$矩阵无需同时存放在内存中。
+ * sink 在互斥锁保护下调用，调用顺序不确定。编译时需要加 -pthread。
+ *
+ * 时间复杂度：$O(NM \log{M} / T)$，T 为线程数
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define MY_INFINITY (1LL << 61)
+
+typedef long long i64;
+
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+struct BFResult {
+    bool valid;
+    std::vector<i64> shortest_distance;
+    std::vector<size_t> parent;
+};
+
+// 从虚拟超级源点出发的 Bellman–Ford，可检测全图上的负环
+BFResult BF_super_source(CSRGraph const &graph) {
+    size_t node_count = graph.node_count();
+
+    bool valid = true;
+    std::vector<i64> shortest_distance;
+    std::vector<size_t> parent;
+
+    shortest_distance.resize(node_count, 0);
+    parent.resize(node_count, 0);
+
+    for (size_t i = 0; i < node_count; i++) {
+        parent[i] = i;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        bool changed = false;
+
+        for (size_t from_node = 0; from_node < node_count; from_node++) {
+            for (size_t j = graph.offset[from_node];
+                 j < graph.offset[from_node + 1]; j++) {
+                size_t to_node = graph.target[j];
+
+                if (shortest_distance[from_node] + graph.weight[j] <
+                    shortest_distance[to_node]) {
+                    shortest_distance[to_node] =
+                        shortest_distance[from_node] + graph.weight[j];
+                    parent[to_node] = from_node;
+                    changed = true;
+                }
+            }
+        }
+
+        if (!changed) {
+            return {valid, shortest_distance, parent};
+        }
+    }
+
+    // 加上超级源点共 N + 1 个点，N 轮之后仍能松弛说明存在负环
+    valid = false;
+
+    return {valid, shortest_distance, parent};
+}
+
+struct NodeInfo {
+    size_t node;
+    i64 distance;
+
+    friend bool operator<(NodeInfo const &left, NodeInfo const &right) {
+        return left.distance > right.distance;
+    }
+
+    explicit constexpr NodeInfo(size_t node_, i64 distance_)
+        : node{node_}, distance{distance_} {}
+};
+
+// sink(size_t source, i64 const *row)：row[v] 为 source 到 v 的最短路，
+// 不可达为 MY_INFINITY。存在负环时返回 false 且不调用 sink
+template <typename Sink>
+bool johnson(CSRGraph const &graph, size_t thread_count, Sink &&sink) {
+    size_t node_count = graph.node_count();
+
+    BFResult potential = BF_super_source(graph);
+
+    if (!potential.valid) {
+        return false;
+    }
+
+    std::vector<i64> const &h = potential.shortest_distance;
+
+    // 重新赋权后的图，边权均非负
+    CSRGraph reweighted = graph;
+
+    for (size_t u = 0; u < node_count; u++) {
+        for (size_t i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+            reweighted.weight[i] += h[u] - h[graph.target[i]];
+        }
+    }
+
+    thread_count = std::max<size_t>(1, std::min(thread_count, node_count));
+
+    std::atomic<size_t> next_source{0};
+    std::mutex sink_mutex;
+
+    auto worker = [&]() {
+        std::vector<i64> row;
+        std::vector<NodeInfo> heap;
+
+        row.resize(node_count);
+
+        while (true) {
+            size_t source = next_source.fetch_add(1, std::memory_order_relaxed);
+
+            if (source >= node_count) {
+                break;
+            }
+
+            std::fill(std::begin(row), std::end(row), MY_INFINITY);
+            heap.clear();
+
+            row[source] = 0;
+            heap.emplace_back(source, 0);
+
+            while (!heap.empty()) {
+                std::pop_heap(std::begin(heap), std::end(heap));
+                NodeInfo top = heap.back();
+                heap.pop_back();
+
+                if (top.distance > row[top.node]) {
+                    continue;
+                }
+
+                for (size_t i = reweighted.offset[top.node];
+                     i < reweighted.offset[top.node + 1]; i++) {
+                    size_t other_node = reweighted.target[i];
+                    i64 new_distance = top.distance + reweighted.weight[i];
+
+                    if (new_distance < row[other_node]) {
+                        row[other_node] = new_distance;
+                        heap.emplace_back(other_node, new_distance);
+                        std::push_heap(std::begin(heap), std::end(heap));
+                    }
+                }
+            }
+
+            for (size_t v = 0; v < node_count; v++) {
+                if (row[v] != MY_INFINITY) {
+                    row[v] += h[v] - h[source];
+                }
+            }
+
+            std::lock_guard<std::mutex> lock{sink_mutex};
+            sink(source, (i64 const *)row.data());
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+    for (size_t t = 1; t < thread_count; t++) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    return true;
+}
@@ -0,0 +1,363 @@
+/*
+ * name: 并行 Bellman–Ford
+ * description:
+ *
+ * parallel_BF()：边以结构体数组（SoA）的形式存放在 EdgeArray 中（from、to、weight 三个连续数组），
+ * 每一轮把边数组分块交给多个线程，用原子的取最小值操作松弛；某一轮没有任何更新时提前结束。
+ * 由于同一轮内可以看到其他线程刚写入的距离，每轮的效果不弱于串行 Bellman–Ford 的一轮，
+ * 因此轮数不超过最短路的最大边数（加一），在最短路边数较少的图上接近线性加速。
+ *
+ * frontier_BF()：每一轮只松弛上一轮距离发生变化的节点的出边（需要 CSR 存图），
+ * 各线程把新变化的节点写入自己的缓冲区，轮末合并为下一轮的前沿。
+ *
+ * 两者都会在第 N 轮仍有更新时报告存在从源点可达的负环。由于并行更新的次序不确定，这里不维护父节点。
+ * 工作线程在每次调用开始时创建一次（WorkerPool），此后每一轮只唤醒它们并等待完成。
+ * 编译时需要加 -pthread。
+ *
+ * 时间复杂度：$O(DM / T)$，D 为最短路的最大边数，T 为线程数
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define MY_INFINITY (1LL << 61)
+
+// 元素少于该值时直接在当前线程执行
+#define PARALLEL_GRAIN 4096
+
+typedef long long i64;
+
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 常驻的工作线程：构造时创建 thread_count - 1 个线程，之后每次 parallel_for() 只唤醒它们，
+// 由当前线程执行第 0 段，各段都完成后返回。相邻两轮之间经过互斥锁同步，上一轮的写入对下一轮可见
+class WorkerPool {
+  public:
+    explicit WorkerPool(size_t thread_count_)
+        : thread_count{std::max<size_t>(thread_count_, 1)}, task{nullptr},
+          invoke{nullptr}, generation{0}, running{0}, stopping{false} {
+        workers.reserve(thread_count - 1);
+
+        for (size_t t = 1; t < thread_count; t++) {
+            workers.emplace_back([this, t]() { work(t); });
+        }
+    }
+
+    WorkerPool(WorkerPool const &) = delete;
+    WorkerPool &operator=(WorkerPool const &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        start.notify_all();
+
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t size() const { return thread_count; }
+
+    // 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+    // 元素较少时直接在当前线程执行，避免唤醒线程的开销
+    template <typename Fn>
+    void parallel_for(size_t count, Fn &&fn) {
+        if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+            fn((size_t)0, (size_t)0, count);
+            return;
+        }
+
+        size_t chunk = (count + thread_count - 1) / thread_count;
+
+        auto run_chunk = [&](size_t t) {
+            size_t begin = std::min(count, t * chunk);
+            size_t end = std::min(count, begin + chunk);
+
+            fn(t, begin, end);
+        };
+
+        dispatch(&run_chunk, &call<decltype(run_chunk)>);
+    }
+
+  private:
+    size_t thread_count;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+
+    // 本轮的任务，由 invoke(task, thread_id) 执行
+    void *task;
+    void (*invoke)(void *, size_t);
+    // 已发布的轮数、本轮尚未完成的工作线程数
+    size_t generation;
+    size_t running;
+    bool stopping;
+
+    template <typename Task>
+    static void call(void *task_, size_t thread_id) {
+        (*static_cast<Task *>(task_))(thread_id);
+    }
+
+    void dispatch(void *task_, void (*invoke_)(void *, size_t)) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            task = task_;
+            invoke = invoke_;
+            running = thread_count - 1;
+            generation++;
+        }
+        start.notify_all();
+
+        invoke_(task_, 0);
+
+        std::unique_lock<std::mutex> lock{mutex};
+        done.wait(lock, [this]() { return running == 0; });
+    }
+
+    void work(size_t thread_id) {
+        size_t seen = 0;
+
+        while (true) {
+            void *current_task = nullptr;
+            void (*current_invoke)(void *, size_t) = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                start.wait(lock,
+                           [&]() { return stopping || generation != seen; });
+
+                if (stopping) {
+                    return;
+                }
+
+                seen = generation;
+                current_task = task;
+                current_invoke = invoke;
+            }
+
+            current_invoke(current_task, thread_id);
+
+            bool last = false;
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                last = --running == 0;
+            }
+
+            if (last) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+// 原子地令 target = min(target, value)，返回是否更新
+bool atomic_min(std::atomic<i64> &target, i64 value) {
+    i64 current = target.load(std::memory_order_relaxed);
+
+    while (value < current) {
+        if (target.compare_exchange_weak(current, value,
+                                         std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// 以 SoA 形式存放的边表
+struct EdgeArray {
+    std::vector<uint32_t> from;
+    std::vector<uint32_t> to;
+    std::vector<i64> weight;
+
+    size_t size() const { return from.size(); }
+
+    void add_edge(size_t from_node, size_t to_node, i64 edge_weight) {
+        from.push_back((uint32_t)from_node);
+        to.push_back((uint32_t)to_node);
+        weight.push_back(edge_weight);
+    }
+};
+
+struct ParallelBFResult {
+    bool valid;
+    std::vector<i64> shortest_distance;
+};
+
+std::vector<i64> to_plain(std::vector<std::atomic<i64>> const &distance) {
+    std::vector<i64> result;
+    result.resize(distance.size());
+
+    for (size_t i = 0; i < distance.size(); i++) {
+        result[i] = distance[i].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+ParallelBFResult parallel_BF(EdgeArray const &edges, size_t node_count,
+                             size_t source_node, size_t thread_count) {
+    std::vector<std::atomic<i64>> distance(node_count);
+    for (std::atomic<i64> &d : distance) {
+        d.store(MY_INFINITY, std::memory_order_relaxed);
+    }
+    distance[source_node].store(0, std::memory_order_relaxed);
+
+    WorkerPool pool{thread_count};
+
+    for (size_t round = 0; round < node_count; round++) {
+        std::atomic<bool> changed{false};
+
+        pool.parallel_for(edges.size(), [&](size_t, size_t begin, size_t end) {
+            bool local_changed = false;
+
+            for (size_t i = begin; i < end; i++) {
+                i64 from_distance =
+                    distance[edges.from[i]].load(std::memory_order_relaxed);
+
+                if (from_distance == MY_INFINITY) {
+                    continue;
+                }
+
+                if (atomic_min(distance[edges.to[i]],
+                               from_distance + edges.weight[i])) {
+                    local_changed = true;
+                }
+            }
+
+            if (local_changed) {
+                changed.store(true, std::memory_order_relaxed);
+            }
+        });
+
+        if (!changed.load(std::memory_order_relaxed)) {
+            return {true, to_plain(distance)};
+        }
+    }
+
+    return {false, to_plain(distance)};
+}
+
+ParallelBFResult frontier_BF(CSRGraph const &graph, size_t source_node,
+                             size_t thread_count) {
+    size_t node_count = graph.node_count();
+
+    WorkerPool pool{thread_count};
+
+    std::vector<std::atomic<i64>> distance(node_count);
+    // 节点最近一次被加入前沿的轮次，用于去重
+    std::vector<std::atomic<size_t>> queued_round(node_count);
+
+    for (size_t i = 0; i < node_count; i++) {
+        distance[i].store(MY_INFINITY, std::memory_order_relaxed);
+        queued_round[i].store(~(size_t)0, std::memory_order_relaxed);
+    }
+    distance[source_node].store(0, std::memory_order_relaxed);
+
+    std::vector<uint32_t> frontier{(uint32_t)source_node};
+    std::vector<std::vector<uint32_t>> next_buffers(pool.size());
+
+    for (size_t round = 0; round < node_count; round++) {
+        if (frontier.empty()) {
+            return {true, to_plain(distance)};
+        }
+
+        pool.parallel_for(
+            frontier.size(), [&](size_t thread_id, size_t begin, size_t end) {
+                std::vector<uint32_t> &buffer = next_buffers[thread_id];
+
+                for (size_t k = begin; k < end; k++) {
+                    size_t u = frontier[k];
+                    i64 du = distance[u].load(std::memory_order_relaxed);
+
+                    for (size_t i = graph.offset[u]; i < graph.offset[u + 1];
+                         i++) {
+                        size_t v = graph.target[i];
+
+                        if (!atomic_min(distance[v], du + graph.weight[i])) {
+                            continue;
+                        }
+
+                        // 每个节点每轮只加入前沿一次
+                        if (queued_round[v].exchange(
+                                round, std::memory_order_relaxed) != round) {
+                            buffer.push_back((uint32_t)v);
+                        }
+                    }
+                }
+            });
+
+        frontier.clear();
+
+        for (std::vector<uint32_t> &buffer : next_buffers) {
+            frontier.insert(std::end(frontier), std::begin(buffer),
+                            std::end(buffer));
+            buffer.clear();
+        }
+    }
+
+    return {frontier.empty(), to_plain(distance)};
+}
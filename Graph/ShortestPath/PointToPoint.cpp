@@ -0,0 +1,349 @@
+/*
+ * name: 点对点最短路（双向 Dijkstra、A*）
+ * description:
+ *
+ * 只需要 s 到 t 的距离时，不必像 dijkstra() 那样求出整张图的单源最短路。
+ *
+ * 双向 Dijkstra：同时从 s 在原图上、从 t 在反图上搜索，每次扩展堆顶较小的一侧。
+ * 设 best 为已发现的最短 s-t 路径，当两侧堆顶之和不小于 best 时停止。
+ *
+ * A*：堆中的键为 $g(v) + h(v)$，其中 h 为调用者给出的可采纳（不高估）的启发函数。
+ * 这里允许节点被重新打开，因此 h 只需可采纳，不必满足一致性。
+ *
+ * 两者都通过父节点数组还原路径。每次询问的状态存放在 PointToPointQuery 中反复使用，
+ * 用时间戳判断节点在本轮是否被访问过，因此每次询问无需$O(N)$清空。
+ *
+ * 边权必须非负
+ *
+ * 时间复杂度：最坏$O(M \log{M})$，通常远小于单源最短路
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define MY_INFINITY (1LL << 60)
+
+typedef long long i64;
+
+// 带权边，用于构建 CSRGraph
+struct WeightedEdge {
+    size_t from;
+    size_t to;
+    i64 weight;
+
+    explicit constexpr WeightedEdge(size_t from_, size_t to_, i64 weight_)
+        : from{from_}, to{to_}, weight{weight_} {}
+};
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target、weight 中下标在
+// [offset[u], offset[u + 1]) 内的元素。三个数组各自连续存放，遍历出边时没有指针跳转
+// 要求节点数小于 2^32
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+    std::vector<i64> weight;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(size_t node_count,
+                   std::vector<WeightedEdge> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+    graph.weight.resize(edge_list.size());
+
+    for (WeightedEdge const &edge : edge_list) {
+        graph.offset[edge.from + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (WeightedEdge const &edge : edge_list) {
+        size_t pos = graph.offset[edge.from]++;
+
+        graph.target[pos] = (uint32_t)edge.to;
+        graph.weight[pos] = edge.weight;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 反图：边 (u, v, w) 变为 (v, u, w)
+CSRGraph reverse_csr(CSRGraph const &graph) {
+    size_t node_count = graph.node_count();
+
+    std::vector<WeightedEdge> edge_list;
+    edge_list.reserve(graph.target.size());
+
+    for (size_t u = 0; u < node_count; u++) {
+        for (size_t i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+            edge_list.emplace_back(graph.target[i], u, graph.weight[i]);
+        }
+    }
+
+    return build_csr(node_count, edge_list);
+}
+
+struct NodeInfo {
+    size_t node;
+    i64 distance;
+
+    friend bool operator<(NodeInfo const &left, NodeInfo const &right) {
+        return left.distance > right.distance;
+    }
+
+    explicit constexpr NodeInfo(size_t node_, i64 distance_)
+        : node{node_}, distance{distance_} {}
+};
+
+struct PathResult {
+    // 不可达时为 MY_INFINITY，path 为空
+    i64 distance;
+    // s, ..., t
+    std::vector<size_t> path;
+};
+
+class PointToPointQuery {
+  public:
+    // 只有双向搜索需要反图，在第一次双向搜索时才构建，只用 A* 时不占用这部分内存
+    explicit PointToPointQuery(CSRGraph const &graph_)
+        : graph{graph_}, round{0} {
+        forward.init(graph.node_count());
+    }
+
+    PathResult bidirectional_dijkstra(size_t source_node, size_t target_node) {
+        if (reversed_graph.offset.empty()) {
+            reversed_graph = reverse_csr(graph);
+            backward.init(graph.node_count());
+        }
+
+        new_round();
+
+        relax(forward, source_node, 0, source_node);
+        relax(backward, target_node, 0, target_node);
+
+        i64 best = MY_INFINITY;
+        size_t meet_node = source_node;
+
+        if (source_node == target_node) {
+            best = 0;
+        }
+
+        while (!forward.heap.empty() && !backward.heap.empty()) {
+            i64 forward_top = forward.heap.front().distance;
+            i64 backward_top = backward.heap.front().distance;
+
+            if (forward_top + backward_top >= best) {
+                break;
+            }
+
+            bool is_forward = forward_top <= backward_top;
+
+            SearchState &state = is_forward ? forward : backward;
+            SearchState &other = is_forward ? backward : forward;
+            CSRGraph const &g = is_forward ? graph : reversed_graph;
+
+            size_t current_node = pop(state);
+
+            if (current_node == NONE) {
+                continue;
+            }
+
+            i64 current_distance = state.distance[current_node];
+
+            for (size_t i = g.offset[current_node];
+                 i < g.offset[current_node + 1]; i++) {
+                size_t other_node = g.target[i];
+
+                relax(state, other_node, current_distance + g.weight[i],
+                      current_node);
+
+                if (other.touched[other_node] == round &&
+                    state.distance[other_node] + other.distance[other_node] <
+                        best) {
+                    best =
+                        state.distance[other_node] + other.distance[other_node];
+                    meet_node = other_node;
+                }
+            }
+        }
+
+        if (best == MY_INFINITY) {
+            return {MY_INFINITY, {}};
+        }
+
+        std::vector<size_t> path;
+
+        for (size_t node = meet_node; node != source_node;
+             node = forward.parent[node]) {
+            path.push_back(node);
+        }
+        path.push_back(source_node);
+        std::reverse(std::begin(path), std::end(path));
+
+        for (size_t node = meet_node; node != target_node;) {
+            node = backward.parent[node];
+            path.push_back(node);
+        }
+
+        return {best, path};
+    }
+
+    // heuristic(v) 返回 v 到 target_node 距离的下界
+    template <typename Heuristic>
+    PathResult astar(size_t source_node, size_t target_node,
+                     Heuristic &&heuristic) {
+        new_round();
+
+        std::vector<NodeInfo> &heap = forward.heap;
+
+        forward.touched[source_node] = round;
+        forward.distance[source_node] = 0;
+        forward.parent[source_node] = source_node;
+        heap.emplace_back(source_node, heuristic(source_node));
+
+        bool found = false;
+
+        while (!heap.empty()) {
+            std::pop_heap(std::begin(heap), std::end(heap));
+            NodeInfo top = heap.back();
+            heap.pop_back();
+
+            size_t current_node = top.node;
+            i64 current_distance = forward.distance[current_node];
+
+            // 过期元素
+            if (top.distance != current_distance + heuristic(current_node)) {
+                continue;
+            }
+
+            if (current_node == target_node) {
+                found = true;
+                break;
+            }
+
+            for (size_t i = graph.offset[current_node];
+                 i < graph.offset[current_node + 1]; i++) {
+                size_t other_node = graph.target[i];
+                i64 new_distance = current_distance + graph.weight[i];
+
+                if (forward.touched[other_node] != round ||
+                    new_distance < forward.distance[other_node]) {
+                    forward.touched[other_node] = round;
+                    forward.distance[other_node] = new_distance;
+                    forward.parent[other_node] = current_node;
+
+                    heap.emplace_back(other_node,
+                                      new_distance + heuristic(other_node));
+                    std::push_heap(std::begin(heap), std::end(heap));
+                }
+            }
+        }
+
+        if (!found) {
+            return {MY_INFINITY, {}};
+        }
+
+        std::vector<size_t> path;
+
+        for (size_t node = target_node; node != source_node;
+             node = forward.parent[node]) {
+            path.push_back(node);
+        }
+        path.push_back(source_node);
+        std::reverse(std::begin(path), std::end(path));
+
+        return {forward.distance[target_node], path};
+    }
+
+  private:
+    // 单方向搜索的状态，touched[v] != round 时 distance[v] 视为无穷大
+    struct SearchState {
+        std::vector<i64> distance;
+        std::vector<size_t> parent;
+        std::vector<uint32_t> touched;
+        std::vector<uint32_t> settled;
+        // 以 NodeInfo::operator< 建堆，堆顶为距离最小的节点
+        std::vector<NodeInfo> heap;
+
+        void init(size_t node_count) {
+            distance.resize(node_count, MY_INFINITY);
+            parent.resize(node_count, 0);
+            touched.resize(node_count, 0);
+            settled.resize(node_count, 0);
+        }
+    };
+
+    CSRGraph const &graph;
+    // 尚未构建时 offset 为空
+    CSRGraph reversed_graph;
+
+    uint32_t round;
+    SearchState forward;
+    SearchState backward;
+
+    static constexpr size_t NONE = ~(size_t)0;
+
+    // 开始新一轮询问，时间戳回绕时才真正清空
+    void new_round() {
+        round++;
+
+        if (round == 0) {
+            std::fill(std::begin(forward.touched), std::end(forward.touched),
+                      0);
+            std::fill(std::begin(forward.settled), std::end(forward.settled),
+                      0);
+            std::fill(std::begin(backward.touched),
+                      std::end(backward.touched), 0);
+            std::fill(std::begin(backward.settled),
+                      std::end(backward.settled), 0);
+            round = 1;
+        }
+
+        forward.heap.clear();
+        backward.heap.clear();
+    }
+
+    void relax(SearchState &state, size_t node, i64 distance,
+               size_t parent_node) {
+        if (state.touched[node] == round && state.distance[node] <= distance) {
+            return;
+        }
+
+        state.touched[node] = round;
+        state.distance[node] = distance;
+        state.parent[node] = parent_node;
+
+        state.heap.emplace_back(node, distance);
+        std::push_heap(std::begin(state.heap), std::end(state.heap));
+    }
+
+    // 弹出堆顶，若为过期元素或已确定的节点则返回 NONE
+    size_t pop(SearchState &state) {
+        std::pop_heap(std::begin(state.heap), std::end(state.heap));
+        NodeInfo top = state.heap.back();
+        state.heap.pop_back();
+
+        if (state.settled[top.node] == round ||
+            top.distance != state.distance[top.node]) {
+            return NONE;
+        }
+
+        state.settled[top.node] = round;
+
+        return top.node;
+    }
+};
@@ -0,0 +1,202 @@
+/*
+ * name: SPFA（SLF + LLL）与子树拆解负环检测
+ * description:
+ *
+ * 队列优化的 Bellman–Ford：只有距离变小的节点才会重新入队并松弛其出边。
+ * - SLF（Small Label First）：新入队节点的距离小于队首时放到队首，否则放到队尾
+ * - LLL（Large Label Last）：队首节点的距离大于队列中距离的平均值时，将其移到队尾
+ *
+ * 负环检测使用 Tarjan 的子树拆解：维护当前的最短路树（按先序存成双向链表，并记录深度）。
+ * 当边 $(u, v)$ 使 v 的距离变小时，v 子树中其他节点的距离都已过时，将它们移出树和队列。
+ * 若 u 恰好在 v 的子树中，则树上 v 到 u 的路径加上边 $(u, v)$ 构成负环，可以立即返回该环。
+ * 相比 Bellman–Ford 跑满 N 轮后再判断，负环通常能被很早发现。
+ *
+ * 与 BF() 相同，只能发现从 [S] 点出发可以抵达的负环；判断全图需要建立超级源点。
+ *
+ * 时间复杂度：最坏$O(MN)$，通常接近线性
+ */
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#define MY_INFINITY (1LL << 61)
+
+typedef long long i64;
+typedef __int128 i128;
+
+struct Edge {
+    size_t to;
+    i64 weight;
+
+    explicit constexpr Edge(size_t to_, i64 weight_)
+        : to{to_}, weight{weight_} {};
+};
+
+struct SPFAResult {
+    bool valid;
+    std::vector<i64> shortest_distance;
+    std::vector<size_t> parent;
+    // valid 为 false 时为负环上的节点，按环上的顺序排列
+    std::vector<size_t> negative_cycle;
+};
+
+SPFAResult spfa(std::vector<std::vector<Edge>> const &graph,
+                size_t source_node) {
+    size_t const NONE = ~(size_t)0;
+
+    size_t node_count = graph.size();
+
+    std::vector<i64> distance;
+    std::vector<size_t> parent;
+    // 节点当前是否在最短路树中
+    std::vector<int> in_tree;
+    // 最短路树的先序链表（以源点为头的循环链表）与深度
+    std::vector<size_t> next;
+    std::vector<size_t> prev;
+    std::vector<size_t> depth;
+
+    distance.resize(node_count, MY_INFINITY);
+    parent.resize(node_count, 0);
+    in_tree.resize(node_count, 0);
+    next.resize(node_count, NONE);
+    prev.resize(node_count, NONE);
+    depth.resize(node_count, 0);
+
+    // 队列中的元素为 (节点, 入队编号)，编号与 queue_token 不符即为已被移出的元素
+    std::deque<std::pair<size_t, size_t>> node_queue;
+    std::vector<size_t> queue_token;
+    std::vector<int> in_queue;
+    i128 queue_sum = 0;
+    size_t queue_count = 0;
+    size_t token = 0;
+
+    queue_token.resize(node_count, 0);
+    in_queue.resize(node_count, 0);
+
+    auto is_queued = [&](std::pair<size_t, size_t> const &item) {
+        return in_queue[item.first] == 1 &&
+               queue_token[item.first] == item.second;
+    };
+
+    auto dequeue = [&](size_t node) {
+        in_queue[node] = 0;
+        queue_sum -= distance[node];
+        queue_count--;
+    };
+
+    distance[source_node] = 0;
+    parent[source_node] = source_node;
+    in_tree[source_node] = 1;
+    next[source_node] = prev[source_node] = source_node;
+
+    in_queue[source_node] = 1;
+    queue_token[source_node] = ++token;
+    queue_count = 1;
+    node_queue.emplace_back(source_node, token);
+
+    while (queue_count > 0) {
+        // 丢弃失效元素，并按 LLL 把距离大于平均值的队首移到队尾
+        while (true) {
+            std::pair<size_t, size_t> front = node_queue.front();
+
+            if (!is_queued(front)) {
+                node_queue.pop_front();
+                continue;
+            }
+
+            if ((i128)distance[front.first] * (i128)queue_count > queue_sum) {
+                node_queue.pop_front();
+                node_queue.push_back(front);
+                continue;
+            }
+
+            break;
+        }
+
+        size_t u = node_queue.front().first;
+        node_queue.pop_front();
+        dequeue(u);
+
+        for (Edge const &edge : graph[u]) {
+            size_t v = edge.to;
+            i64 new_distance = distance[u] + edge.weight;
+
+            if (new_distance >= distance[v]) {
+                continue;
+            }
+
+            if (in_tree[v] == 1) {
+                if (v == u) {
+                    return {false, distance, parent, {u}};
+                }
+
+                // 拆解 v 的子树（先序链表中紧跟 v 且深度更大的节点）
+                size_t x = next[v];
+
+                while (x != v && depth[x] > depth[v]) {
+                    if (x == u) {
+                        std::vector<size_t> cycle;
+
+                        for (size_t node = u; node != v; node = parent[node]) {
+                            cycle.push_back(node);
+                        }
+                        cycle.push_back(v);
+
+                        return {false, distance, parent,
+                                {cycle.rbegin(), cycle.rend()}};
+                    }
+
+                    in_tree[x] = 0;
+
+                    if (in_queue[x] == 1) {
+                        dequeue(x);
+                    }
+
+                    x = next[x];
+                }
+
+                // 从链表中摘下 v 及其子树
+                next[prev[v]] = x;
+                prev[x] = prev[v];
+            }
+
+            if (in_queue[v] == 1) {
+                queue_sum -= distance[v] - new_distance;
+            }
+
+            distance[v] = new_distance;
+            parent[v] = u;
+            in_tree[v] = 1;
+            depth[v] = depth[u] + 1;
+
+            // 作为 u 的第一个孩子插入先序链表
+            next[v] = next[u];
+            prev[v] = u;
+            prev[next[u]] = v;
+            next[u] = v;
+
+            if (in_queue[v] == 0) {
+                in_queue[v] = 1;
+                queue_token[v] = ++token;
+                queue_sum += new_distance;
+                queue_count++;
+
+                // SLF
+                while (!node_queue.empty() && !is_queued(node_queue.front())) {
+                    node_queue.pop_front();
+                }
+
+                if (!node_queue.empty() &&
+                    new_distance < distance[node_queue.front().first]) {
+                    node_queue.emplace_front(v, token);
+                } else {
+                    node_queue.emplace_back(v, token);
+                }
+            }
+        }
+    }
+
+    return {true, distance, parent, {}};
+}
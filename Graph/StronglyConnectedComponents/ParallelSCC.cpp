@@ -0,0 +1,660 @@
+/*
+ * name: 并行强连通分量（修剪 + 前向-后向可达性）
+ *
+ * description:
+ *
+ * 1. 修剪：子问题内入度或出度为 0 的节点自成一个分量。删去后可能产生新的这类节点，按前沿逐层并行处理，
+ *    用原子操作维护剩余的入度、出度，工作量与子问题的节点数及其边数成正比
+ * 2. 前向-后向（FW-BW）：在一个子问题（颜色相同的节点集合 S）中随机选取枢轴 p，
+ *    并行 BFS 求出 S 内 p 能到达的节点 FW 与能到达 p 的节点 BW，$FW \cap BW$ 即 p 所在的分量。
+ *    其余的强连通分量必然完全落在 $FW \setminus BW$、$BW \setminus FW$、$S \setminus (FW \cup BW)$ 之一中，
+ *    给这三部分分别染上新颜色，各自再修剪一次后作为新的子问题继续处理。
+ *    枢轴若固定取编号最小的节点，在一串首尾相连的小环上每轮只能分出一个环，总代价为平方级；
+ *    随机选取时与快速排序类似，期望只需$O(\log{N})$层
+ * 3. 节点数少于 SEQUENTIAL_SCC_LIMIT 的子问题不再拆分，收集起来后由各线程分别用迭代式 Tarjan 求解
+ *
+ * 修剪与 BFS 的每一层都要同步一次，工作线程在构造时创建一次（WorkerPool），各层只唤醒它们并等待完成。
+ *
+ * 分量编号为分量中最小的节点编号，与求解顺序无关。canonical_components() 把
+ * DFSStronglyConnectedComponents.cpp 中 dfs_pass2() 得到的 scc_by_node 转换成同样的编号，以便互相校验。
+ *
+ * 编译时需要加 -pthread。要求节点数小于 2^32 - 1
+ *
+ * 时间复杂度：期望$O((N + M) \log{N})$，最坏$O(NM)$
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 元素少于该值时直接在当前线程执行
+#define PARALLEL_GRAIN 4096
+
+// 节点数少于该值的子问题直接用 Tarjan 求解
+#define SEQUENTIAL_SCC_LIMIT 4096
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target 中下标在 [offset[u], offset[u + 1]) 内的元素
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表 (from, to) 按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(
+    size_t node_count,
+    std::vector<std::pair<uint32_t, uint32_t>> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+
+    for (std::pair<uint32_t, uint32_t> const &edge : edge_list) {
+        graph.offset[edge.first + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (std::pair<uint32_t, uint32_t> const &edge : edge_list) {
+        graph.target[graph.offset[edge.first]++] = edge.second;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 反图：节点 v 的出边为原图中指向 v 的边
+CSRGraph reverse_csr(CSRGraph const &graph) {
+    size_t node_count = graph.node_count();
+
+    CSRGraph reversed;
+
+    reversed.offset.resize(node_count + 1, 0);
+    reversed.target.resize(graph.target.size());
+
+    for (uint32_t to_node : graph.target) {
+        reversed.offset[to_node + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        reversed.offset[i + 1] += reversed.offset[i];
+    }
+
+    for (size_t u = 0; u < node_count; u++) {
+        for (size_t i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+            reversed.target[reversed.offset[graph.target[i]]++] = (uint32_t)u;
+        }
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        reversed.offset[i] = reversed.offset[i - 1];
+    }
+    reversed.offset[0] = 0;
+
+    return reversed;
+}
+
+// 常驻的工作线程：构造时创建 thread_count - 1 个线程，之后每次 parallel_for() 只唤醒它们，
+// 由当前线程执行第 0 段，各段都完成后返回。相邻两轮之间经过互斥锁同步，上一轮的写入对下一轮可见
+class WorkerPool {
+  public:
+    explicit WorkerPool(size_t thread_count_)
+        : thread_count{std::max<size_t>(thread_count_, 1)}, task{nullptr},
+          invoke{nullptr}, generation{0}, running{0}, stopping{false} {
+        workers.reserve(thread_count - 1);
+
+        for (size_t t = 1; t < thread_count; t++) {
+            workers.emplace_back([this, t]() { work(t); });
+        }
+    }
+
+    WorkerPool(WorkerPool const &) = delete;
+    WorkerPool &operator=(WorkerPool const &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        start.notify_all();
+
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t size() const { return thread_count; }
+
+    // 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+    // 元素较少时直接在当前线程执行，避免唤醒线程的开销
+    template <typename Fn>
+    void parallel_for(size_t count, Fn &&fn) {
+        if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+            fn((size_t)0, (size_t)0, count);
+            return;
+        }
+
+        size_t chunk = (count + thread_count - 1) / thread_count;
+
+        auto run_chunk = [&](size_t t) {
+            size_t begin = std::min(count, t * chunk);
+            size_t end = std::min(count, begin + chunk);
+
+            fn(t, begin, end);
+        };
+
+        dispatch(&run_chunk, &call<decltype(run_chunk)>);
+    }
+
+  private:
+    size_t thread_count;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+
+    // 本轮的任务，由 invoke(task, thread_id) 执行
+    void *task;
+    void (*invoke)(void *, size_t);
+    // 已发布的轮数、本轮尚未完成的工作线程数
+    size_t generation;
+    size_t running;
+    bool stopping;
+
+    template <typename Task>
+    static void call(void *task_, size_t thread_id) {
+        (*static_cast<Task *>(task_))(thread_id);
+    }
+
+    void dispatch(void *task_, void (*invoke_)(void *, size_t)) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            task = task_;
+            invoke = invoke_;
+            running = thread_count - 1;
+            generation++;
+        }
+        start.notify_all();
+
+        invoke_(task_, 0);
+
+        std::unique_lock<std::mutex> lock{mutex};
+        done.wait(lock, [this]() { return running == 0; });
+    }
+
+    void work(size_t thread_id) {
+        size_t seen = 0;
+
+        while (true) {
+            void *current_task = nullptr;
+            void (*current_invoke)(void *, size_t) = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                start.wait(lock,
+                           [&]() { return stopping || generation != seen; });
+
+                if (stopping) {
+                    return;
+                }
+
+                seen = generation;
+                current_task = task;
+                current_invoke = invoke;
+            }
+
+            current_invoke(current_task, thread_id);
+
+            bool last = false;
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                last = --running == 0;
+            }
+
+            if (last) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+uint32_t const NO_COMPONENT = ~(uint32_t)0;
+
+class ParallelSCC {
+  private:
+    static constexpr uint8_t TRIMMED = 1;
+    static constexpr uint8_t FORWARD = 2;
+    static constexpr uint8_t BACKWARD = 4;
+
+    CSRGraph const &graph;
+    CSRGraph reversed_graph;
+    size_t thread_count;
+    WorkerPool pool;
+
+    std::vector<uint32_t> component;
+    std::vector<uint32_t> color;
+    // 节点在所属小子问题中的下标，Tarjan 使用
+    std::vector<uint32_t> slot;
+    std::vector<std::atomic<uint8_t>> flag;
+
+    // 修剪时子问题内剩余的入度、出度
+    std::vector<std::atomic<uint32_t>> in_count;
+    std::vector<std::atomic<uint32_t>> out_count;
+
+    uint32_t color_count;
+
+    std::mt19937 urbg;
+
+  public:
+    explicit ParallelSCC(CSRGraph const &graph_, size_t thread_count_)
+        : graph{graph_}, reversed_graph{reverse_csr(graph_)},
+          thread_count{std::max<size_t>(thread_count_, 1)},
+          pool{thread_count_}, flag(graph_.node_count()),
+          in_count(graph_.node_count()), out_count(graph_.node_count()),
+          color_count{0}, urbg{84841984} {}
+
+    // 返回每个节点所在分量的编号（分量中最小的节点编号）
+    std::vector<uint32_t> run() {
+        size_t node_count = graph.node_count();
+
+        component.assign(node_count, NO_COMPONENT);
+        color.assign(node_count, 0);
+        slot.assign(node_count, 0);
+        color_count = 1;
+
+        for (std::atomic<uint8_t> &f : flag) {
+            f.store(0, std::memory_order_relaxed);
+        }
+
+        std::vector<uint32_t> all_nodes;
+        all_nodes.resize(node_count);
+        for (size_t v = 0; v < node_count; v++) {
+            all_nodes[v] = (uint32_t)v;
+        }
+
+        std::vector<std::vector<uint32_t>> tasks;
+        std::vector<std::vector<uint32_t>> small_tasks;
+
+        push_task(std::move(all_nodes), tasks);
+
+        while (!tasks.empty()) {
+            std::vector<uint32_t> nodes = std::move(tasks.back());
+            tasks.pop_back();
+
+            if (nodes.size() < SEQUENTIAL_SCC_LIMIT) {
+                small_tasks.push_back(std::move(nodes));
+                continue;
+            }
+
+            forward_backward(nodes, tasks);
+        }
+
+        solve_small_tasks(small_tasks);
+
+        return std::move(component);
+    }
+
+  private:
+    // 将 frontier 与每轮新加入的节点拼接起来，直到没有新节点
+    // visit(thread_id, node, buffer) 把 node 扩展出的新节点写入 buffer
+    template <typename Visit>
+    void expand(std::vector<uint32_t> &frontier, Visit &&visit) {
+        std::vector<std::vector<uint32_t>> next_buffers(thread_count);
+
+        size_t begin = 0;
+
+        while (begin < frontier.size()) {
+            size_t end = frontier.size();
+            uint32_t const *level = frontier.data() + begin;
+
+            pool.parallel_for(end - begin, [&](size_t thread_id, size_t lo,
+                                               size_t hi) {
+                for (size_t k = lo; k < hi; k++) {
+                    visit(level[k], next_buffers[thread_id]);
+                }
+            });
+
+            for (std::vector<uint32_t> &buffer : next_buffers) {
+                frontier.insert(std::end(frontier), std::begin(buffer),
+                                std::end(buffer));
+                buffer.clear();
+            }
+
+            begin = end;
+        }
+    }
+
+    bool claim(uint32_t node, uint8_t bit) {
+        return (flag[node].fetch_or(bit, std::memory_order_relaxed) & bit) ==
+               0;
+    }
+
+    // 删去子问题 nodes 中可以修剪的节点，nodes 只保留剩下的节点
+    // 子问题刚染色时其中的节点都尚未确定分量，因此只需比较颜色
+    void trim(std::vector<uint32_t> &nodes) {
+        uint32_t color_id = color[nodes[0]];
+
+        std::vector<std::vector<uint32_t>> zero_buffers(thread_count);
+
+        pool.parallel_for(nodes.size(), [&](size_t thread_id, size_t begin,
+                                            size_t end) {
+            for (size_t k = begin; k < end; k++) {
+                uint32_t v = nodes[k];
+                uint32_t in_degree = 0;
+                uint32_t out_degree = 0;
+
+                for (size_t i = graph.offset[v]; i < graph.offset[v + 1];
+                     i++) {
+                    out_degree += color[graph.target[i]] == color_id;
+                }
+
+                for (size_t i = reversed_graph.offset[v];
+                     i < reversed_graph.offset[v + 1]; i++) {
+                    in_degree += color[reversed_graph.target[i]] == color_id;
+                }
+
+                in_count[v].store(in_degree, std::memory_order_relaxed);
+                out_count[v].store(out_degree, std::memory_order_relaxed);
+
+                if (in_degree == 0 || out_degree == 0) {
+                    claim(v, TRIMMED);
+                    zero_buffers[thread_id].push_back(v);
+                }
+            }
+        });
+
+        std::vector<uint32_t> frontier;
+
+        for (std::vector<uint32_t> &buffer : zero_buffers) {
+            frontier.insert(std::end(frontier), std::begin(buffer),
+                            std::end(buffer));
+        }
+
+        if (frontier.empty()) {
+            return;
+        }
+
+        expand(frontier, [&](uint32_t u, std::vector<uint32_t> &buffer) {
+            component[u] = u;
+
+            for (size_t i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+                uint32_t w = graph.target[i];
+
+                if (color[w] == color_id &&
+                    in_count[w].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    claim(w, TRIMMED)) {
+                    buffer.push_back(w);
+                }
+            }
+
+            for (size_t i = reversed_graph.offset[u];
+                 i < reversed_graph.offset[u + 1]; i++) {
+                uint32_t w = reversed_graph.target[i];
+
+                if (color[w] == color_id &&
+                    out_count[w].fetch_sub(1, std::memory_order_relaxed) ==
+                        1 &&
+                    claim(w, TRIMMED)) {
+                    buffer.push_back(w);
+                }
+            }
+        });
+
+        nodes.erase(std::remove_if(std::begin(nodes), std::end(nodes),
+                                   [&](uint32_t v) {
+                                       return component[v] != NO_COMPONENT;
+                                   }),
+                    std::end(nodes));
+    }
+
+    // 较大的子问题先修剪再加入 tasks，较小的留给 Tarjan
+    void push_task(std::vector<uint32_t> &&nodes,
+                   std::vector<std::vector<uint32_t>> &tasks) {
+        if (nodes.size() >= SEQUENTIAL_SCC_LIMIT) {
+            trim(nodes);
+        }
+
+        if (!nodes.empty()) {
+            tasks.push_back(std::move(nodes));
+        }
+    }
+
+    // 从 pivot 出发在颜色 color_id 内 BFS，给到达的节点打上 bit
+    void reach(CSRGraph const &g, uint32_t pivot, uint32_t color_id,
+               uint8_t bit) {
+        std::vector<uint32_t> frontier{pivot};
+        claim(pivot, bit);
+
+        expand(frontier, [&](uint32_t u, std::vector<uint32_t> &buffer) {
+            for (size_t i = g.offset[u]; i < g.offset[u + 1]; i++) {
+                uint32_t w = g.target[i];
+
+                if (color[w] == color_id && component[w] == NO_COMPONENT &&
+                    claim(w, bit)) {
+                    buffer.push_back(w);
+                }
+            }
+        });
+    }
+
+    void forward_backward(std::vector<uint32_t> const &nodes,
+                          std::vector<std::vector<uint32_t>> &tasks) {
+        uint32_t color_id = color[nodes[0]];
+        uint32_t pivot = nodes[std::uniform_int_distribution<size_t>{
+            0, nodes.size() - 1}(urbg)];
+
+        reach(graph, pivot, color_id, FORWARD);
+        reach(reversed_graph, pivot, color_id, BACKWARD);
+
+        uint32_t min_node = pivot;
+
+        for (uint32_t v : nodes) {
+            uint8_t f = flag[v].load(std::memory_order_relaxed);
+
+            if ((f & FORWARD) && (f & BACKWARD)) {
+                min_node = std::min(min_node, v);
+            }
+        }
+
+        // 0：都不可达，1：仅 FW，2：仅 BW
+        std::vector<uint32_t> parts[3];
+        uint32_t part_color[3] = {color_count, color_count + 1,
+                                  color_count + 2};
+        color_count += 3;
+
+        for (uint32_t v : nodes) {
+            uint8_t f = flag[v].load(std::memory_order_relaxed);
+
+            flag[v].store(f & (uint8_t)~(FORWARD | BACKWARD),
+                          std::memory_order_relaxed);
+
+            if ((f & FORWARD) && (f & BACKWARD)) {
+                component[v] = min_node;
+                continue;
+            }
+
+            size_t part = (f & FORWARD) ? 1 : ((f & BACKWARD) ? 2 : 0);
+
+            color[v] = part_color[part];
+            parts[part].push_back(v);
+        }
+
+        for (std::vector<uint32_t> &part : parts) {
+            push_task(std::move(part), tasks);
+        }
+    }
+
+    void solve_small_tasks(std::vector<std::vector<uint32_t>> const &tasks) {
+        std::atomic<size_t> next_task{0};
+
+        size_t worker_count =
+            std::max<size_t>(1, std::min(thread_count, tasks.size()));
+
+        auto worker = [&]() {
+            while (true) {
+                size_t i = next_task.fetch_add(1, std::memory_order_relaxed);
+
+                if (i >= tasks.size()) {
+                    break;
+                }
+
+                tarjan(tasks[i]);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(worker_count - 1);
+
+        for (size_t t = 1; t < worker_count; t++) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    // 在 nodes 内做迭代式 Tarjan（Pearce 写法），各子问题的节点与颜色互不相同，
+    // 因此不同线程可以同时处理不同的子问题
+    void tarjan(std::vector<uint32_t> const &nodes) {
+        struct Frame {
+            uint32_t node;
+            bool root;
+            size_t cursor;
+        };
+
+        uint32_t color_id = color[nodes[0]];
+
+        // 同色且尚未确定分量的节点属于本子问题
+        auto is_member = [&](uint32_t node) {
+            return color[node] == color_id && component[node] == NO_COMPONENT;
+        };
+
+        for (size_t k = 0; k < nodes.size(); k++) {
+            slot[nodes[k]] = (uint32_t)k;
+        }
+
+        // 以 nodes 中的下标存放，0 表示未访问
+        std::vector<uint32_t> rindex;
+        rindex.resize(nodes.size(), 0);
+
+        std::vector<Frame> dfs_stack;
+        std::vector<uint32_t> node_stack;
+
+        uint32_t index = 1;
+
+        for (uint32_t start : nodes) {
+            if (rindex[slot[start]] != 0) {
+                continue;
+            }
+
+            rindex[slot[start]] = index++;
+            dfs_stack.push_back({start, true, graph.offset[start]});
+
+            while (!dfs_stack.empty()) {
+                Frame &frame = dfs_stack.back();
+                uint32_t v = frame.node;
+
+                if (frame.cursor < graph.offset[v + 1]) {
+                    uint32_t w = graph.target[frame.cursor];
+
+                    // 已完成的节点不再影响 rindex，与其他子问题的节点一样跳过
+                    if (!is_member(w)) {
+                        frame.cursor++;
+                        continue;
+                    }
+
+                    if (rindex[slot[w]] == 0) {
+                        rindex[slot[w]] = index++;
+                        dfs_stack.push_back({w, true, graph.offset[w]});
+                        continue;
+                    }
+
+                    if (rindex[slot[w]] < rindex[slot[v]]) {
+                        rindex[slot[v]] = rindex[slot[w]];
+                        frame.root = false;
+                    }
+
+                    frame.cursor++;
+                    continue;
+                }
+
+                bool root = frame.root;
+                dfs_stack.pop_back();
+
+                if (!root) {
+                    node_stack.push_back(v);
+                    continue;
+                }
+
+                // 节点栈中 DFS 序不小于 v 的节点与 v 同属一个分量
+                size_t count = 0;
+                uint32_t min_node = v;
+
+                while (count < node_stack.size()) {
+                    uint32_t w = node_stack[node_stack.size() - 1 - count];
+
+                    if (rindex[slot[w]] < rindex[slot[v]]) {
+                        break;
+                    }
+
+                    min_node = std::min(min_node, w);
+                    count++;
+                }
+
+                for (size_t k = 0; k < count; k++) {
+                    component[node_stack.back()] = min_node;
+                    node_stack.pop_back();
+                }
+
+                component[v] = min_node;
+            }
+        }
+    }
+};
+
+// 返回每个节点所在分量的编号（分量中最小的节点编号）
+std::vector<uint32_t> parallel_scc(CSRGraph const &graph, size_t thread_count) {
+    return ParallelSCC{graph, thread_count}.run();
+}
+
+// 把 dfs_pass2() 的结果（scc_by_node[root] 为以 root 为根的分量中的节点）转换为同样的编号
+std::vector<uint32_t> canonical_components(
+    std::vector<std::vector<size_t>> const &scc_by_node, size_t node_count) {
+    std::vector<uint32_t> result;
+    result.resize(node_count, NO_COMPONENT);
+
+    for (std::vector<size_t> const &members : scc_by_node) {
+        if (members.empty()) {
+            continue;
+        }
+
+        size_t min_node =
+            *std::min_element(std::begin(members), std::end(members));
+
+        for (size_t node : members) {
+            result[node] = (uint32_t)min_node;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,230 @@
+/*
+ * name: 迭代式 Tarjan 强连通分量（Pearce 的省内存写法）
+ *
+ * description:
+ *
+ * 一遍 DFS 求出所有强连通分量，不需要反图。DFS 使用显式栈，每个栈帧为 (节点, 出边游标, 是否为根)，
+ * 因此不会像递归写法那样在很深的链上栈溢出。
+ *
+ * Pearce 的写法不单独存 low 值：rindex[v] 在访问时设为 DFS 序，回溯时取后继中的最小值；
+ * 一个分量完成后，其中所有节点的 rindex 被改写为分量编号（从 N - 1 开始递减），
+ * 由于分量编号总是大于任何仍在使用的 DFS 序，已完成的节点不会再影响其他节点的最小值。
+ * 最终 rindex 直接作为分量编号数组返回，额外内存只有 DFS 栈与节点栈，均不超过$O(N)$，与边数无关。
+ *
+ * 分量编号为 [0, component_count)，并按缩点后的拓扑序排列：若有边从分量 a 指向分量 b（a != b），则 a < b。
+ *
+ * condensation() 求缩点后的 DAG（CSR 形式，去掉重边与自环）。
+ *
+ * 要求节点数小于 2^32 - 1
+ *
+ * 时间复杂度：$O(N + M)$
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 压缩稀疏行（CSR）存图：节点 u 的出边为 target 中下标在 [offset[u], offset[u + 1]) 内的元素
+struct CSRGraph {
+    std::vector<size_t> offset;
+    std::vector<uint32_t> target;
+
+    size_t node_count() const { return offset.size() - 1; }
+};
+
+// 对边表 (from, to) 按起点做一趟计数排序，得到 CSR
+CSRGraph build_csr(
+    size_t node_count,
+    std::vector<std::pair<uint32_t, uint32_t>> const &edge_list) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_count + 1, 0);
+    graph.target.resize(edge_list.size());
+
+    for (std::pair<uint32_t, uint32_t> const &edge : edge_list) {
+        graph.offset[edge.first + 1]++;
+    }
+
+    for (size_t i = 0; i < node_count; i++) {
+        graph.offset[i + 1] += graph.offset[i];
+    }
+
+    // 放置后 offset[u] 变为 u 的出边结束位置，再整体右移一位还原
+    for (std::pair<uint32_t, uint32_t> const &edge : edge_list) {
+        graph.target[graph.offset[edge.first]++] = edge.second;
+    }
+
+    for (size_t i = node_count; i > 0; i--) {
+        graph.offset[i] = graph.offset[i - 1];
+    }
+    graph.offset[0] = 0;
+
+    return graph;
+}
+
+// 由邻接表构建 CSR
+CSRGraph build_csr(std::vector<std::vector<size_t>> const &node_to_edges) {
+    CSRGraph graph;
+
+    graph.offset.resize(node_to_edges.size() + 1, 0);
+
+    for (size_t i = 0; i < node_to_edges.size(); i++) {
+        graph.offset[i + 1] = graph.offset[i] + node_to_edges[i].size();
+    }
+
+    graph.target.reserve(graph.offset.back());
+
+    for (std::vector<size_t> const &out_list : node_to_edges) {
+        for (size_t out_node : out_list) {
+            graph.target.push_back((uint32_t)out_node);
+        }
+    }
+
+    return graph;
+}
+
+struct SCCResult {
+    size_t component_count;
+    std::vector<uint32_t> component;
+};
+
+SCCResult tarjan_scc(CSRGraph const &graph) {
+    struct Frame {
+        uint32_t node;
+        bool root;
+        size_t cursor;
+    };
+
+    size_t node_count = graph.node_count();
+
+    // 0 表示未访问
+    std::vector<uint32_t> rindex;
+    rindex.resize(node_count, 0);
+
+    std::vector<Frame> dfs_stack;
+    std::vector<uint32_t> node_stack;
+
+    uint32_t index = 1;
+    uint32_t component_id = (uint32_t)node_count - 1;
+
+    for (size_t start = 0; start < node_count; start++) {
+        if (rindex[start] != 0) {
+            continue;
+        }
+
+        rindex[start] = index++;
+        dfs_stack.push_back({(uint32_t)start, true, graph.offset[start]});
+
+        while (!dfs_stack.empty()) {
+            Frame &frame = dfs_stack.back();
+            uint32_t v = frame.node;
+
+            if (frame.cursor < graph.offset[v + 1]) {
+                uint32_t w = graph.target[frame.cursor];
+
+                // 先访问 w，返回后游标仍指向 w，再用它更新 rindex[v]
+                if (rindex[w] == 0) {
+                    rindex[w] = index++;
+                    dfs_stack.push_back({w, true, graph.offset[w]});
+                    continue;
+                }
+
+                if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    frame.root = false;
+                }
+
+                frame.cursor++;
+                continue;
+            }
+
+            bool root = frame.root;
+            dfs_stack.pop_back();
+
+            if (!root) {
+                node_stack.push_back(v);
+                continue;
+            }
+
+            // v 为分量的根，节点栈中 DFS 序不小于 v 的节点与 v 同属一个分量
+            index--;
+
+            while (!node_stack.empty() &&
+                   rindex[v] <= rindex[node_stack.back()]) {
+                rindex[node_stack.back()] = component_id;
+                node_stack.pop_back();
+                index--;
+            }
+
+            rindex[v] = component_id;
+            component_id--;
+        }
+    }
+
+    // 先完成的分量编号较大，且为缩点后拓扑序靠后的分量，平移到 [0, component_count)
+    uint32_t shift = component_id + 1;
+    size_t component_count = node_count - shift;
+
+    for (uint32_t &id : rindex) {
+        id -= shift;
+    }
+
+    return {component_count, std::move(rindex)};
+}
+
+// 缩点后的 DAG，节点为分量编号
+CSRGraph condensation(CSRGraph const &graph, SCCResult const &scc) {
+    size_t node_count = graph.node_count();
+    size_t component_count = scc.component_count;
+
+    // 按分量对节点做计数排序
+    std::vector<size_t> member_offset;
+    std::vector<uint32_t> member;
+
+    member_offset.resize(component_count + 1, 0);
+    member.resize(node_count);
+
+    for (uint32_t id : scc.component) {
+        member_offset[id + 1]++;
+    }
+
+    for (size_t i = 0; i < component_count; i++) {
+        member_offset[i + 1] += member_offset[i];
+    }
+
+    for (size_t v = 0; v < node_count; v++) {
+        member[member_offset[scc.component[v]]++] = (uint32_t)v;
+    }
+
+    for (size_t i = component_count; i > 0; i--) {
+        member_offset[i] = member_offset[i - 1];
+    }
+    member_offset[0] = 0;
+
+    CSRGraph dag;
+    dag.offset.resize(component_count + 1, 0);
+
+    // last_seen[d] == c 表示分量 c 已有指向 d 的边
+    std::vector<uint32_t> last_seen;
+    last_seen.resize(component_count, ~(uint32_t)0);
+
+    for (size_t c = 0; c < component_count; c++) {
+        for (size_t k = member_offset[c]; k < member_offset[c + 1]; k++) {
+            uint32_t v = member[k];
+
+            for (size_t i = graph.offset[v]; i < graph.offset[v + 1]; i++) {
+                uint32_t d = scc.component[graph.target[i]];
+
+                if (d != c && last_seen[d] != c) {
+                    last_seen[d] = (uint32_t)c;
+                    dag.target.push_back(d);
+                }
+            }
+        }
+
+        dag.offset[c + 1] = dag.target.size();
+    }
+
+    return dag;
+}
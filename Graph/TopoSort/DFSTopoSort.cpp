@@ -3,10 +3,21 @@
  *
  * description:
  *
+ * dfs_graph() 为递归写法，图很深时会栈溢出。
  *
+ * DFSWorkspace 为迭代写法：显式栈的每个栈帧为 (节点, 出边游标)，所有状态都存放在工作区对象中，
+ * 同一个工作区可以反复使用。每次遍历用轮次号判断节点在本轮是否已被访问，不需要清空数组，
+ * 节点数不超过以前的最大值时不会分配内存。
+ *
+ * 遍历过程通过回调给出发现时间、完成时间与边的分类（时间戳从 1 开始，发现、完成各占一个时刻）：
+ * - 树边：v 尚未被访问
+ * - 后向边：v 已被发现但尚未完成（v 是 u 的祖先，图中有环）
+ * - 前向边：v 已完成且 v 比 u 后被发现（v 是 u 的后代）
+ * - 横跨边：其他情况
  */
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdio>
 #include <vector>
 
@@ -56,6 +67,119 @@ void dfs_graph() {
     std::reverse(std::begin(topo_list), std::end(topo_list));
 }
 
+enum class EdgeType { TREE, BACK, FORWARD, CROSS };
+
+// 不需要某个回调时传入
+struct NoCallback {
+    template <typename... Args>
+    void operator()(Args &&...) const {}
+};
+
+class DFSWorkspace {
+  private:
+    struct Frame {
+        size_t node;
+        size_t cursor;
+    };
+
+    std::vector<size_t> visit_round;
+    size_t round = 0;
+
+    std::vector<Frame> dfs_stack;
+
+  public:
+    // 仅对本轮访问过的节点有意义；exit_time 为 0 表示已被发现但尚未完成
+    std::vector<size_t> dfs_parent;
+    std::vector<size_t> enter_time;
+    std::vector<size_t> exit_time;
+
+    bool is_visited(size_t node) const { return visit_round[node] == round; }
+
+    // 从 first_node 开始依次以每个未访问的节点为根遍历全图
+    // on_discover(node, time)、on_finish(node, time)、on_edge(from, to, type)
+    template <typename OnDiscover, typename OnFinish, typename OnEdge>
+    void run(std::vector<std::vector<size_t>> const &adjacency,
+             size_t first_node, OnDiscover &&on_discover, OnFinish &&on_finish,
+             OnEdge &&on_edge) {
+        size_t node_count = adjacency.size();
+
+        if (visit_round.size() < node_count) {
+            visit_round.resize(node_count, 0);
+            dfs_parent.resize(node_count, 0);
+            enter_time.resize(node_count, 0);
+            exit_time.resize(node_count, 0);
+        }
+
+        round++;
+
+        size_t time = 0;
+
+        auto discover = [&](size_t node, size_t parent_node) {
+            visit_round[node] = round;
+            dfs_parent[node] = parent_node;
+            enter_time[node] = ++time;
+            exit_time[node] = 0;
+            dfs_stack.push_back({node, 0});
+            on_discover(node, time);
+        };
+
+        for (size_t root = first_node; root < node_count; root++) {
+            if (is_visited(root)) {
+                continue;
+            }
+
+            discover(root, root);
+
+            while (!dfs_stack.empty()) {
+                Frame &frame = dfs_stack.back();
+                size_t u = frame.node;
+
+                if (frame.cursor == adjacency[u].size()) {
+                    dfs_stack.pop_back();
+                    exit_time[u] = ++time;
+                    on_finish(u, time);
+                    continue;
+                }
+
+                size_t v = adjacency[u][frame.cursor++];
+
+                if (!is_visited(v)) {
+                    on_edge(u, v, EdgeType::TREE);
+                    discover(v, u);
+                } else if (exit_time[v] == 0) {
+                    on_edge(u, v, EdgeType::BACK);
+                } else if (enter_time[v] > enter_time[u]) {
+                    on_edge(u, v, EdgeType::FORWARD);
+                } else {
+                    on_edge(u, v, EdgeType::CROSS);
+                }
+            }
+        }
+    }
+};
+
+// 用迭代 DFS 求拓扑序，结果写入 order（复用其容量），图中有环时返回 false
+bool iterative_topo_sort(std::vector<std::vector<size_t>> const &adjacency,
+                         size_t first_node, DFSWorkspace &workspace,
+                         std::vector<size_t> &order) {
+    bool acyclic = true;
+
+    order.clear();
+
+    workspace.run(
+        adjacency, first_node, NoCallback{},
+        [&](size_t node, size_t) { order.push_back(node); },
+        [&](size_t, size_t, EdgeType type) {
+            if (type == EdgeType::BACK) {
+                acyclic = false;
+            }
+        });
+
+    std::reverse(std::begin(order), std::end(order));
+
+    return acyclic;
+}
+
 int main(void) {
     size_t N = 0;
 
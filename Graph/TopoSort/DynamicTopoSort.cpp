@@ -0,0 +1,291 @@
+/*
+ * name: 动态拓扑排序（Pearce–Kelly）
+ *
+ * description:
+ *
+ * 维护一张不断加边的 DAG 的拓扑序，每次加边后不必重新拓扑排序。
+ *
+ * 记 position[v] 为 v 在当前拓扑序中的位置。加入边 $(u, v)$ 时：
+ * - 若 position[u] < position[v]，拓扑序仍然合法，直接加入
+ * - 否则只有位置在 [position[v], position[u]] 之间的节点可能需要调整（受影响区域）：
+ *   从 v 出发沿出边搜索区域内的节点（集合 F），若能到达 u 则加边后成环，拒绝该边；
+ *   再从 u 出发沿入边搜索区域内的节点（集合 B）。把 B、F 原来占据的位置排序后，
+ *   先按原顺序依次分给 B 中的节点，再依次分给 F 中的节点，其他节点不动
+ *
+ * 批量加边 add_edges()：与当前拓扑序一致的边直接加入；其余边的受影响区域取并集得到一个区间，
+ * 对区间内的节点（只考虑区间内部的边）做一次 Kahn 排序，再按新顺序填回这些位置。
+ * 区间外的边不受影响，因此整体仍是合法的拓扑序。环必然经过冲突的边且落在区间内，Kahn 排序成功时
+ * 加入整批边后仍无环，与逐条加入的结果相同；若区间内出现环，则撤销本批所有的边，按输入顺序逐条调用
+ * add_edge()。因此返回值总是与按输入顺序逐条调用 add_edge() 一致。最坏情况下区间为整张图，
+ * 代价与重新拓扑排序相同。
+ *
+ * 0 下标，搜索使用显式栈，每次搜索用时间戳标记访问过的节点，不需要清空
+ *
+ * 时间复杂度：单次加边$O(\delta \log{\delta})$，$\delta$ 为受影响区域中被搜索到的节点及其边数
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class DynamicTopoOrder {
+  private:
+    std::vector<std::vector<size_t>> out_edges;
+    std::vector<std::vector<size_t>> in_edges;
+
+    // position[node_at[i]] = i
+    std::vector<size_t> position;
+    std::vector<size_t> node_at;
+
+    std::vector<size_t> visit_round;
+    size_t round;
+
+    std::vector<size_t> node_stack;
+    std::vector<size_t> forward_set;
+    std::vector<size_t> backward_set;
+    std::vector<size_t> slots;
+
+    // 批量加边时 Kahn 排序使用
+    std::vector<size_t> in_count;
+
+  public:
+    explicit DynamicTopoOrder(size_t node_count)
+        : out_edges(node_count), in_edges(node_count), position(node_count),
+          node_at(node_count), visit_round(node_count, 0), round{0},
+          in_count(node_count, 0) {
+        for (size_t i = 0; i < node_count; i++) {
+            position[i] = node_at[i] = i;
+        }
+    }
+
+    size_t node_count() const { return position.size(); }
+
+    // 当前的拓扑序
+    std::vector<size_t> const &order() const { return node_at; }
+
+    size_t index_of(size_t node) const { return position[node]; }
+
+    // 加入边 (from, to)，若会形成环则不加入并返回 false
+    bool add_edge(size_t from, size_t to) {
+        if (from == to) {
+            return false;
+        }
+
+        size_t lower = position[to];
+        size_t upper = position[from];
+
+        if (lower < upper) {
+            round++;
+
+            if (!search_forward(to, from, upper)) {
+                return false;
+            }
+
+            search_backward(from, lower);
+            reorder();
+        }
+
+        out_edges[from].push_back(to);
+        in_edges[to].push_back(from);
+
+        return true;
+    }
+
+    // 批量加边，返回值的第 i 个元素表示 edges[i] 是否被加入
+    // 结果与按输入顺序逐条调用 add_edge() 相同
+    std::vector<int> add_edges(
+        std::vector<std::pair<size_t, size_t>> const &edges) {
+        std::vector<int> accepted;
+        accepted.resize(edges.size(), 1);
+
+        std::vector<size_t> pending;
+        size_t lower = node_count();
+        size_t upper = 0;
+
+        for (size_t i = 0; i < edges.size(); i++) {
+            size_t from = edges[i].first;
+            size_t to = edges[i].second;
+
+            if (from == to) {
+                accepted[i] = 0;
+                continue;
+            }
+
+            out_edges[from].push_back(to);
+            in_edges[to].push_back(from);
+
+            if (position[from] > position[to]) {
+                pending.push_back(i);
+                lower = std::min(lower, position[to]);
+                upper = std::max(upper, position[from]);
+            }
+        }
+
+        if (pending.empty() || reorder_window(lower, upper)) {
+            return accepted;
+        }
+
+        // 区间内有环：撤销本批所有的边，按输入顺序逐条加入
+        for (size_t i = edges.size(); i-- > 0;) {
+            if (edges[i].first != edges[i].second) {
+                remove_last(out_edges[edges[i].first], edges[i].second);
+                remove_last(in_edges[edges[i].second], edges[i].first);
+            }
+        }
+
+        for (size_t i = 0; i < edges.size(); i++) {
+            accepted[i] = add_edge(edges[i].first, edges[i].second) ? 1 : 0;
+        }
+
+        return accepted;
+    }
+
+  private:
+    // 从 start 沿出边搜索位置不超过 upper 的节点，到达 target 时返回 false
+    bool search_forward(size_t start, size_t target, size_t upper) {
+        forward_set.clear();
+        node_stack.clear();
+
+        visit_round[start] = round;
+        node_stack.push_back(start);
+
+        while (!node_stack.empty()) {
+            size_t node = node_stack.back();
+            node_stack.pop_back();
+
+            forward_set.push_back(node);
+
+            for (size_t next_node : out_edges[node]) {
+                if (next_node == target) {
+                    return false;
+                }
+
+                if (visit_round[next_node] != round &&
+                    position[next_node] < upper) {
+                    visit_round[next_node] = round;
+                    node_stack.push_back(next_node);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // 从 start 沿入边搜索位置大于 lower 的节点
+    void search_backward(size_t start, size_t lower) {
+        backward_set.clear();
+        node_stack.clear();
+
+        visit_round[start] = round;
+        node_stack.push_back(start);
+
+        while (!node_stack.empty()) {
+            size_t node = node_stack.back();
+            node_stack.pop_back();
+
+            backward_set.push_back(node);
+
+            for (size_t prev_node : in_edges[node]) {
+                if (visit_round[prev_node] != round &&
+                    position[prev_node] > lower) {
+                    visit_round[prev_node] = round;
+                    node_stack.push_back(prev_node);
+                }
+            }
+        }
+    }
+
+    // B 中的节点按原顺序排在 F 中的节点之前，共用两者原来占据的位置
+    void reorder() {
+        auto by_position = [this](size_t a, size_t b) {
+            return position[a] < position[b];
+        };
+
+        std::sort(std::begin(forward_set), std::end(forward_set), by_position);
+        std::sort(std::begin(backward_set), std::end(backward_set),
+                  by_position);
+
+        slots.clear();
+
+        for (size_t node : backward_set) {
+            slots.push_back(position[node]);
+        }
+        for (size_t node : forward_set) {
+            slots.push_back(position[node]);
+        }
+
+        std::sort(std::begin(slots), std::end(slots));
+
+        size_t k = 0;
+
+        for (size_t node : backward_set) {
+            position[node] = slots[k];
+            node_at[slots[k]] = node;
+            k++;
+        }
+        for (size_t node : forward_set) {
+            position[node] = slots[k];
+            node_at[slots[k]] = node;
+            k++;
+        }
+    }
+
+    // 对位置在 [lower, upper] 内的节点做 Kahn 排序并填回，有环时不做修改并返回 false
+    bool reorder_window(size_t lower, size_t upper) {
+        for (size_t i = lower; i <= upper; i++) {
+            for (size_t next_node : out_edges[node_at[i]]) {
+                if (position[next_node] >= lower &&
+                    position[next_node] <= upper) {
+                    in_count[next_node]++;
+                }
+            }
+        }
+
+        // node_stack 用作 Kahn 的队列，初始节点按原顺序加入
+        node_stack.clear();
+
+        for (size_t i = lower; i <= upper; i++) {
+            if (in_count[node_at[i]] == 0) {
+                node_stack.push_back(node_at[i]);
+            }
+        }
+
+        for (size_t head = 0; head < node_stack.size(); head++) {
+            for (size_t next_node : out_edges[node_stack[head]]) {
+                if (position[next_node] < lower ||
+                    position[next_node] > upper) {
+                    continue;
+                }
+
+                if (--in_count[next_node] == 0) {
+                    node_stack.push_back(next_node);
+                }
+            }
+        }
+
+        if (node_stack.size() < upper - lower + 1) {
+            for (size_t i = lower; i <= upper; i++) {
+                in_count[node_at[i]] = 0;
+            }
+
+            return false;
+        }
+
+        for (size_t k = 0; k < node_stack.size(); k++) {
+            position[node_stack[k]] = lower + k;
+            node_at[lower + k] = node_stack[k];
+        }
+
+        return true;
+    }
+
+    static void remove_last(std::vector<size_t> &list, size_t node) {
+        for (size_t i = list.size(); i > 0; i--) {
+            if (list[i - 1] == node) {
+                list.erase(std::begin(list) + (std::ptrdiff_t)(i - 1));
+                return;
+            }
+        }
+    }
+};
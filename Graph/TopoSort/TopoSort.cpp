@@ -3,11 +3,26 @@
  *
  * description:
  *
+ * parallel_topo_sort()：按层并行的 Kahn 算法。每一轮并行处理当前入度为 0 的节点（前沿），
+ * 用原子操作减少后继的入度，减到 0 的节点写入各线程的缓冲区，轮末拼接为下一轮的前沿。
+ * 除拓扑序外还给出每个节点所在的层号，同层的节点之间没有依赖，可以同时调度。
+ * 拓扑序唯一当且仅当每层恰好一个节点，因此唯一性只需每层判断一次。
+ * 工作线程在每次调用开始时创建一次（WorkerPool），各层只唤醒它们并等待完成。编译时需要加 -pthread。
+ *
  * Verdict: P1347: https://www.luogu.com.cn/record/192509279
  */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
+// 元素少于该值时直接在当前线程执行
+#define PARALLEL_GRAIN 4096
+
 struct TopoResult {
     int result_code;
     std::vector<size_t> result;
@@ -71,4 +86,224 @@ TopoResult topo_sort(std::vector<std::vector<size_t>> const &graph) {
     TopoResult r = {result_code, result};
 
     return r;
-}
\ No newline at end of file
+}
+
+// 常驻的工作线程：构造时创建 thread_count - 1 个线程，之后每次 parallel_for() 只唤醒它们，
+// 由当前线程执行第 0 段，各段都完成后返回。相邻两轮之间经过互斥锁同步，上一轮的写入对下一轮可见
+class WorkerPool {
+  public:
+    explicit WorkerPool(size_t thread_count_)
+        : thread_count{std::max<size_t>(thread_count_, 1)}, task{nullptr},
+          invoke{nullptr}, generation{0}, running{0}, stopping{false} {
+        workers.reserve(thread_count - 1);
+
+        for (size_t t = 1; t < thread_count; t++) {
+            workers.emplace_back([this, t]() { work(t); });
+        }
+    }
+
+    WorkerPool(WorkerPool const &) = delete;
+    WorkerPool &operator=(WorkerPool const &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        start.notify_all();
+
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t size() const { return thread_count; }
+
+    // 将 [0, count) 分成 thread_count 段并行执行 fn(thread_id, begin, end)
+    // 元素较少时直接在当前线程执行，避免唤醒线程的开销
+    template <typename Fn>
+    void parallel_for(size_t count, Fn &&fn) {
+        if (thread_count <= 1 || count < PARALLEL_GRAIN) {
+            fn((size_t)0, (size_t)0, count);
+            return;
+        }
+
+        size_t chunk = (count + thread_count - 1) / thread_count;
+
+        auto run_chunk = [&](size_t t) {
+            size_t begin = std::min(count, t * chunk);
+            size_t end = std::min(count, begin + chunk);
+
+            fn(t, begin, end);
+        };
+
+        dispatch(&run_chunk, &call<decltype(run_chunk)>);
+    }
+
+  private:
+    size_t thread_count;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+
+    // 本轮的任务，由 invoke(task, thread_id) 执行
+    void *task;
+    void (*invoke)(void *, size_t);
+    // 已发布的轮数、本轮尚未完成的工作线程数
+    size_t generation;
+    size_t running;
+    bool stopping;
+
+    template <typename Task>
+    static void call(void *task_, size_t thread_id) {
+        (*static_cast<Task *>(task_))(thread_id);
+    }
+
+    void dispatch(void *task_, void (*invoke_)(void *, size_t)) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            task = task_;
+            invoke = invoke_;
+            running = thread_count - 1;
+            generation++;
+        }
+        start.notify_all();
+
+        invoke_(task_, 0);
+
+        std::unique_lock<std::mutex> lock{mutex};
+        done.wait(lock, [this]() { return running == 0; });
+    }
+
+    void work(size_t thread_id) {
+        size_t seen = 0;
+
+        while (true) {
+            void *current_task = nullptr;
+            void (*current_invoke)(void *, size_t) = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                start.wait(lock,
+                           [&]() { return stopping || generation != seen; });
+
+                if (stopping) {
+                    return;
+                }
+
+                seen = generation;
+                current_task = task;
+                current_invoke = invoke;
+            }
+
+            current_invoke(current_task, thread_id);
+
+            bool last = false;
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                last = --running == 0;
+            }
+
+            if (last) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+struct ParallelTopoResult {
+    // 含义与 TopoResult 相同
+    int result_code;
+    std::vector<size_t> result;
+    // 节点所在的层号，有环时无法排出的节点为 NO_LEVEL
+    std::vector<size_t> level;
+};
+
+size_t const NO_LEVEL = ~(size_t)0;
+
+ParallelTopoResult parallel_topo_sort(
+    std::vector<std::vector<size_t>> const &graph, size_t thread_count) {
+    size_t node_count = graph.size();
+
+    WorkerPool pool{thread_count};
+
+    std::vector<std::atomic<size_t>> in_count(node_count);
+
+    for (std::atomic<size_t> &count : in_count) {
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    pool.parallel_for(node_count, [&](size_t, size_t begin, size_t end) {
+        for (size_t u = begin; u < end; u++) {
+            for (size_t out_node : graph[u]) {
+                in_count[out_node].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    int result_code = 0;
+    std::vector<size_t> result;
+    std::vector<size_t> level;
+
+    result.reserve(node_count);
+    level.resize(node_count, NO_LEVEL);
+
+    for (size_t i = 0; i < node_count; i++) {
+        if (in_count[i].load(std::memory_order_relaxed) == 0) {
+            result.push_back(i);
+        }
+    }
+
+    std::vector<std::vector<size_t>> next_buffers(pool.size());
+
+    size_t level_begin = 0;
+    size_t current_level = 0;
+
+    // result 中 [level_begin, level_end) 为当前层
+    while (level_begin < result.size()) {
+        size_t level_end = result.size();
+
+        if (level_end - level_begin > 1) {
+            result_code = 2;
+        }
+
+        size_t const *frontier = result.data() + level_begin;
+
+        pool.parallel_for(
+            level_end - level_begin,
+            [&](size_t thread_id, size_t begin, size_t end) {
+                std::vector<size_t> &buffer = next_buffers[thread_id];
+
+                for (size_t k = begin; k < end; k++) {
+                    size_t current_node = frontier[k];
+
+                    level[current_node] = current_level;
+
+                    for (size_t other_node : graph[current_node]) {
+                        if (in_count[other_node].fetch_sub(
+                                1, std::memory_order_relaxed) == 1) {
+                            buffer.push_back(other_node);
+                        }
+                    }
+                }
+            });
+
+        for (std::vector<size_t> &buffer : next_buffers) {
+            result.insert(std::end(result), std::begin(buffer),
+                          std::end(buffer));
+            buffer.clear();
+        }
+
+        level_begin = level_end;
+        current_level++;
+    }
+
+    if (result.size() < node_count) {
+        result_code = 1;
+    }
+
+    return {result_code, result, level};
+}
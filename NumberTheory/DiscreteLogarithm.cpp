@@ -0,0 +1,240 @@
+/*
+ * name: 离散对数（BSGS、拓展 BSGS）
+ * description:
+ *
+ * 求最小的非负整数 x，使得 $a^x \equiv b \pmod p$。
+ *
+ * BSGS 要求 gcd(a, p) = 1：取步长 m，预处理小步 $a^j (0 \le j < m)$ 存入哈希表，再枚举大步 $b \cdot a^{-im}$ 查表，得到 $x = im + j$。
+ *
+ * 小步表只与 a、p 有关，因此 BSGS 对象构造一次后可以反复回答不同 b 的询问。若询问次数为 q，取小步数 $m \approx \sqrt{pq}$ 可使总复杂度最优。
+ *
+ * 哈希表为开放寻址（线性探测）的扁平表，哈希函数为乘法移位（Fibonacci hashing），比 std::unordered_map 少一次指针跳转。
+ *
+ * 拓展 BSGS 处理 a、p 不互质的情况：不断约去 gcd(a, p)，最后化为互质的情形。
+ *
+ * 注意：要求 $p < 2^{31}$，否则乘法会溢出 i64
+ *
+ * 时间复杂度：预处理$O(m)$，单次询问$O(p / m)$
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+typedef long long number;
+typedef unsigned long long u64;
+
+// a ^ b mod n
+number modular_exponentiation(number a, number b, number n) {
+    number result = 1;
+    number temp = a % n;
+
+    while (b > 0) {
+        number current_digit = b % 2;
+
+        if (current_digit == 1) {
+            result = (result * temp) % n;
+        }
+
+        temp = (temp * temp) % n;
+
+        b /= 2;
+    }
+
+    return result;
+}
+
+// d = gcd(a, b) = ax + by
+struct EEResult {
+    number d;
+    number x;
+    number y;
+};
+
+EEResult exgcd(number a, number b) {
+    a = std::abs(a);
+    b = std::abs(b);
+
+    number x = 1, y = 0;
+
+    number x1 = 0, y1 = 1, a1 = a, b1 = b;
+    while (b1 > 0) {
+        number q = a1 / b1;
+        std::tie(x, x1) = std::make_tuple(x1, x - q * x1);
+        std::tie(y, y1) = std::make_tuple(y1, y - q * y1);
+        std::tie(a1, b1) = std::make_tuple(b1, a1 - q * b1);
+    }
+    return EEResult{a1, x, y};
+}
+
+// 键为非负整数的开放寻址哈希表，容量为 2 的幂，只支持插入与查询
+class FlatHashMap {
+  private:
+    static constexpr u64 EMPTY_KEY = ~0ULL;
+
+    std::vector<u64> keys;
+    std::vector<number> values;
+    size_t mask;
+    int shift;
+
+  public:
+    // 负载因子不超过 1/2
+    explicit FlatHashMap(size_t expected_size) {
+        size_t capacity = 2;
+        int bits = 1;
+
+        while (capacity < 2 * expected_size) {
+            capacity <<= 1;
+            bits++;
+        }
+
+        keys.resize(capacity, EMPTY_KEY);
+        values.resize(capacity, 0);
+        mask = capacity - 1;
+        shift = 64 - bits;
+    }
+
+    // 若 key 已存在则保留旧值
+    void insert(u64 key, number value) {
+        size_t idx = slot(key);
+
+        while (keys[idx] != EMPTY_KEY) {
+            if (keys[idx] == key) {
+                return;
+            }
+            idx = (idx + 1) & mask;
+        }
+
+        keys[idx] = key;
+        values[idx] = value;
+    }
+
+    // 找不到时返回 -1
+    number find(u64 key) const {
+        size_t idx = slot(key);
+
+        while (keys[idx] != EMPTY_KEY) {
+            if (keys[idx] == key) {
+                return values[idx];
+            }
+            idx = (idx + 1) & mask;
+        }
+
+        return -1;
+    }
+
+  private:
+    size_t slot(u64 key) const {
+        return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+};
+
+// 固定底数 a 与模数 p（gcd(a, p) = 1），可多次询问
+class BSGS {
+  private:
+    number p;
+    number m;
+    // a^{-m} mod p
+    number giant_step;
+    FlatHashMap baby_steps;
+
+  public:
+    // baby_step_count 为 0 时取 ceil(sqrt(p))
+    explicit BSGS(number a, number p_, number baby_step_count = 0)
+        : p{p_}, m{baby_step_count > 0 ? baby_step_count
+                                       : (number)std::ceil(std::sqrt(
+                                             (double)p_))},
+          giant_step{0}, baby_steps{(size_t)m} {
+        a %= p;
+
+        number current = 1 % p;
+        for (number j = 0; j < m; j++) {
+            baby_steps.insert((u64)current, j);
+            current = current * a % p;
+        }
+
+        EEResult r = exgcd(modular_exponentiation(a, m, p), p);
+        giant_step = ((r.x % p) + p) % p;
+    }
+
+    // 求最小的 x >= 0 使 a^x = b (mod p)，无解返回 -1
+    number log(number b) const {
+        b = ((b % p) + p) % p;
+
+        number giant_count = (p + m - 1) / m;
+        number current = b;
+
+        for (number i = 0; i <= giant_count; i++) {
+            number j = baby_steps.find((u64)current);
+
+            if (j >= 0) {
+                return i * m + j;
+            }
+
+            current = current * giant_step % p;
+        }
+
+        return -1;
+    }
+
+    // 对多个 b 询问，共享同一张小步表
+    std::vector<number> log(std::vector<number> const &b_list) const {
+        std::vector<number> result;
+        result.reserve(b_list.size());
+
+        for (number b : b_list) {
+            result.push_back(log(b));
+        }
+
+        return result;
+    }
+};
+
+// 拓展 BSGS：a、p 可以不互质，无解返回 -1
+number ex_discrete_log(number a, number b, number p) {
+    a = ((a % p) + p) % p;
+    b = ((b % p) + p) % p;
+
+    if (p == 1 || b == 1 % p) {
+        return 0;
+    }
+
+    number k = 0;
+    // 约去的系数 (a / d_1)(a / d_2)... mod p
+    number coefficient = 1;
+
+    while (true) {
+        number d = exgcd(a, p).d;
+
+        if (d == 1) {
+            break;
+        }
+
+        if (b % d != 0) {
+            return -1;
+        }
+
+        b /= d;
+        p /= d;
+        k++;
+        coefficient = coefficient * (a / d) % p;
+
+        if (coefficient == b) {
+            return k;
+        }
+    }
+
+    // a^{x - k} = b * coefficient^{-1} (mod p)
+    EEResult r = exgcd(coefficient, p);
+    number target = b * (((r.x % p) + p) % p) % p;
+
+    number x = BSGS{a, p}.log(target);
+
+    if (x < 0) {
+        return -1;
+    }
+
+    return x + k;
+}
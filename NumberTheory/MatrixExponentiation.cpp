@@ -0,0 +1,411 @@
+/*
+ * name: 矩阵快速幂、常系数线性递推（Kitamasa）
+ * description:
+ *
+ * 模 p 意义下的 N 阶方阵乘法与快速幂。乘法按 i-k-j 顺序进行，并对 k 分块：
+ * 元素小于 p，故每个乘积不超过 $(p - 1)^2$，在 u64 中可以连续累加若干项后再统一取模（延迟取模），
+ * 取模次数从 $N^3$ 次降为约 $N^3 / B$ 次。每一块中 B 的对应若干行可以留在缓存里被 A 的每一行复用。
+ *
+ * 对于 k 阶常系数线性递推 $a_n = \sum_{i = 1}^{k} c_ia_{n - i}$，用矩阵快速幂需要$O(k^3\log{n})$，
+ * 而 Kitamasa 算法求 $x^n \bmod f(x)$（$f(x) = x^k - \sum c_ix^{k - i}$），只需要$O(k^2\log{n})$；
+ * 当 k 较大时，多项式乘法与取模改用拆位 FFT 与牛顿迭代求逆，降为$O(k\log{k}\log{n})$。
+ *
+ * 注意：要求 $p < 2^{32}$
+ *
+ * 时间复杂度：矩阵快速幂$O(N^3\log{e})$，Kitamasa $O(k\log{k}\log{n})$
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef unsigned long long u64;
+
+// 多项式长度不小于该值时使用 FFT，否则使用朴素乘法
+#define POLY_FFT_THRESHOLD 64
+
+// 矩阵乘法中 k 方向的最大分块大小
+#define MATRIX_BLOCK 64
+
+double const PI = std::acos(-1);
+
+using Complex = std::complex<double>;
+
+struct ModMatrix {
+    size_t n;
+    u64 p;
+    // 行优先存储，元素均小于 p
+    std::vector<uint32_t> data;
+
+    explicit ModMatrix(size_t n_, u64 p_) : n{n_}, p{p_} {
+        data.resize(n * n, 0);
+    }
+
+    static ModMatrix identity(size_t n, u64 p) {
+        ModMatrix result{n, p};
+
+        for (size_t i = 0; i < n; i++) {
+            result.at(i, i) = (uint32_t)(1 % p);
+        }
+
+        return result;
+    }
+
+    uint32_t &at(size_t i, size_t j) { return data[i * n + j]; }
+    uint32_t at(size_t i, size_t j) const { return data[i * n + j]; }
+
+    friend ModMatrix operator*(ModMatrix const &left, ModMatrix const &right) {
+        size_t n = left.n;
+        u64 p = left.p;
+
+        ModMatrix result{n, p};
+
+        // 累加器取模后小于 p，之后还能安全累加 safe_terms 个乘积
+        u64 max_product = (p - 1) * (p - 1);
+        u64 safe_terms = MATRIX_BLOCK;
+
+        if (max_product > 0) {
+            safe_terms = std::min<u64>(safe_terms,
+                                       (~0ULL - (p - 1)) / max_product);
+        }
+
+        size_t block = (size_t)safe_terms;
+
+        std::vector<u64> accumulator;
+        accumulator.resize(n * n, 0);
+
+        for (size_t kk = 0; kk < n; kk += block) {
+            size_t k_end = std::min(n, kk + block);
+
+            for (size_t i = 0; i < n; i++) {
+                u64 *acc_row = &accumulator[i * n];
+
+                for (size_t k = kk; k < k_end; k++) {
+                    u64 a = left.data[i * n + k];
+
+                    if (a == 0) {
+                        continue;
+                    }
+
+                    uint32_t const *b_row = &right.data[k * n];
+
+                    for (size_t j = 0; j < n; j++) {
+                        acc_row[j] += a * b_row[j];
+                    }
+                }
+
+                for (size_t j = 0; j < n; j++) {
+                    acc_row[j] %= p;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < n * n; i++) {
+            result.data[i] = (uint32_t)accumulator[i];
+        }
+
+        return result;
+    }
+};
+
+// base ^ e
+ModMatrix matrix_power(ModMatrix base, u64 e) {
+    ModMatrix result = ModMatrix::identity(base.n, base.p);
+
+    while (e > 0) {
+        if (e % 2 == 1) {
+            result = result * base;
+        }
+
+        base = base * base;
+
+        e /= 2;
+    }
+
+    return result;
+}
+
+// 单位根直接由下标计算，而非逐次累乘，以保证拆位 FFT 的精度
+// len 必须是 2^k 形式，reverse == false 时是 DFT，reverse == true 时是 IDFT
+void fft(std::vector<Complex> &y, std::vector<Complex> const &roots,
+         bool reverse) {
+    size_t len = y.size();
+
+    for (size_t i = 1, j = 0; i < len; i++) {
+        size_t bit = len >> 1;
+        for (; (j & bit) != 0; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            std::swap(y[i], y[j]);
+        }
+    }
+
+    for (size_t h = 2; h <= len; h <<= 1) {
+        size_t step = len / h;
+
+        for (size_t j = 0; j < len; j += h) {
+            for (size_t k = j; k < j + h / 2; k++) {
+                Complex w = roots[(k - j) * step];
+
+                if (reverse) {
+                    w = std::conj(w);
+                }
+
+                Complex u = y[k];
+                Complex t = w * y[k + h / 2];
+                y[k] = u + t;
+                y[k + h / 2] = u - t;
+            }
+        }
+    }
+
+    if (reverse) {
+        for (size_t i = 0; i < len; i++) {
+            y[i] /= (double)len;
+        }
+    }
+}
+
+// 模 p 多项式乘法，系数均小于 p
+std::vector<u64> poly_multiply(std::vector<u64> const &a,
+                               std::vector<u64> const &b, u64 p) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+
+    size_t result_len = a.size() + b.size() - 1;
+
+    std::vector<u64> result;
+    result.resize(result_len, 0);
+
+    if (std::min(a.size(), b.size()) < POLY_FFT_THRESHOLD) {
+        for (size_t i = 0; i < a.size(); i++) {
+            for (size_t j = 0; j < b.size(); j++) {
+                result[i + j] = (result[i + j] + a[i] * b[j]) % p;
+            }
+        }
+
+        return result;
+    }
+
+    size_t len = 1;
+    while (len < result_len) {
+        len <<= 1;
+    }
+
+    std::vector<Complex> roots;
+    roots.resize(len / 2);
+    for (size_t i = 0; i < len / 2; i++) {
+        roots[i] = std::polar(1.0, 2 * PI * (double)i / (double)len);
+    }
+
+    // 每个系数拆为 hi * 2^16 + lo
+    std::vector<Complex> a_lo, a_hi, b_lo, b_hi;
+    a_lo.resize(len);
+    a_hi.resize(len);
+    b_lo.resize(len);
+    b_hi.resize(len);
+
+    for (size_t i = 0; i < a.size(); i++) {
+        a_lo[i] = (double)(a[i] & 0xFFFF);
+        a_hi[i] = (double)(a[i] >> 16);
+    }
+
+    for (size_t i = 0; i < b.size(); i++) {
+        b_lo[i] = (double)(b[i] & 0xFFFF);
+        b_hi[i] = (double)(b[i] >> 16);
+    }
+
+    fft(a_lo, roots, false);
+    fft(a_hi, roots, false);
+    fft(b_lo, roots, false);
+    fft(b_hi, roots, false);
+
+    std::vector<Complex> c_hi, c_mid, c_lo;
+    c_hi.resize(len);
+    c_mid.resize(len);
+    c_lo.resize(len);
+
+    for (size_t i = 0; i < len; i++) {
+        c_hi[i] = a_hi[i] * b_hi[i];
+        c_mid[i] = a_hi[i] * b_lo[i] + a_lo[i] * b_hi[i];
+        c_lo[i] = a_lo[i] * b_lo[i];
+    }
+
+    fft(c_hi, roots, true);
+    fft(c_mid, roots, true);
+    fft(c_lo, roots, true);
+
+    u64 base = (1ULL << 16) % p;
+    u64 base2 = base * base % p;
+
+    for (size_t i = 0; i < result_len; i++) {
+        u64 hi = (u64)std::llround(c_hi[i].real()) % p;
+        u64 mid = (u64)std::llround(c_mid[i].real()) % p;
+        u64 lo = (u64)std::llround(c_lo[i].real()) % p;
+
+        result[i] = (hi * base2 % p + mid * base % p + lo) % p;
+    }
+
+    return result;
+}
+
+// 求 g 使 f * g = 1 (mod x^n)，要求 f[0] 在模 p 下可逆（p 为质数）
+std::vector<u64> poly_inverse(std::vector<u64> const &f, size_t n, u64 p) {
+    // f[0]^{p - 2}
+    u64 f0_inverse = 1;
+    {
+        u64 temp = f[0] % p;
+        u64 e = p - 2;
+
+        while (e > 0) {
+            if (e % 2 == 1) {
+                f0_inverse = f0_inverse * temp % p;
+            }
+            temp = temp * temp % p;
+            e /= 2;
+        }
+    }
+
+    std::vector<u64> g{f0_inverse};
+
+    // g' = g(2 - fg) mod x^{2m}
+    for (size_t m = 1; m < n; m <<= 1) {
+        size_t next = std::min(2 * m, n);
+
+        std::vector<u64> f_prefix(
+            std::begin(f), std::begin(f) + (long)std::min(next, f.size()));
+
+        std::vector<u64> fg = poly_multiply(f_prefix, g, p);
+        fg.resize(next, 0);
+
+        for (u64 &x : fg) {
+            x = (p - x) % p;
+        }
+        fg[0] = (fg[0] + 2) % p;
+
+        g = poly_multiply(g, fg, p);
+        g.resize(next, 0);
+    }
+
+    g.resize(n, 0);
+
+    return g;
+}
+
+// 常系数线性递推：a_n = c_1 a_{n - 1} + ... + c_k a_{n - k}（p 为质数）
+class LinearRecurrence {
+  private:
+    size_t k;
+    u64 p;
+    std::vector<u64> initial;
+    // f(x) = x^k - c_1 x^{k - 1} - ... - c_k，低次在前
+    std::vector<u64> modulus;
+    // rev(f)^{-1} mod x^{k - 1}
+    std::vector<u64> modulus_rev_inverse;
+
+  public:
+    // coefficient_list = [c_1, ..., c_k]，initial_list = [a_0, ..., a_{k - 1}]
+    explicit LinearRecurrence(std::vector<u64> const &coefficient_list,
+                              std::vector<u64> const &initial_list, u64 p_)
+        : k{coefficient_list.size()}, p{p_}, initial{initial_list} {
+        modulus.resize(k + 1);
+        modulus[k] = 1 % p;
+
+        for (size_t i = 1; i <= k; i++) {
+            modulus[k - i] = (p - coefficient_list[i - 1] % p) % p;
+        }
+
+        if (k >= POLY_FFT_THRESHOLD) {
+            std::vector<u64> rev(std::rbegin(modulus), std::rend(modulus));
+            modulus_rev_inverse = poly_inverse(rev, k - 1, p);
+        }
+    }
+
+    // 求 a_n
+    u64 nth(u64 n) const {
+        if (k == 0) {
+            return 0;
+        }
+
+        if (n < k) {
+            return initial[n] % p;
+        }
+
+        // r(x) = x^n mod f(x)，从最高位开始：r = r^2，若该位为 1 则 r = r * x
+        std::vector<u64> r{1 % p};
+
+        int top = 63;
+        while (((n >> top) & 1) == 0) {
+            top--;
+        }
+
+        for (int bit = top; bit >= 0; bit--) {
+            r = poly_mod(poly_multiply(r, r, p));
+
+            if (((n >> bit) & 1) == 1) {
+                r.insert(std::begin(r), 0);
+                r = poly_mod(std::move(r));
+            }
+        }
+
+        u64 result = 0;
+        for (size_t i = 0; i < r.size(); i++) {
+            result = (result + r[i] * (initial[i] % p)) % p;
+        }
+
+        return result;
+    }
+
+  private:
+    // a mod f，要求 deg a <= 2k - 2
+    std::vector<u64> poly_mod(std::vector<u64> a) const {
+        if (a.size() <= k) {
+            return a;
+        }
+
+        if (k < POLY_FFT_THRESHOLD || a.size() - k == 1) {
+            // 朴素带余除法，f 为首一多项式
+            for (size_t i = a.size() - 1; i >= k; i--) {
+                u64 q = a[i];
+
+                if (q != 0) {
+                    for (size_t j = 0; j < k; j++) {
+                        a[i - k + j] =
+                            (a[i - k + j] + (p - q) * modulus[j]) % p;
+                    }
+                }
+            }
+
+            a.resize(k);
+            return a;
+        }
+
+        // rev(q) = rev(a) * rev(f)^{-1} mod x^{deg a - k + 1}
+        size_t q_len = a.size() - k;
+
+        std::vector<u64> a_rev(std::rbegin(a), std::rbegin(a) + (long)q_len);
+        std::vector<u64> inv(std::begin(modulus_rev_inverse),
+                             std::begin(modulus_rev_inverse) + (long)q_len);
+
+        std::vector<u64> q = poly_multiply(a_rev, inv, p);
+        q.resize(q_len);
+        std::reverse(std::begin(q), std::end(q));
+
+        // r = a - q * f，只需低 k 项
+        std::vector<u64> qf = poly_multiply(q, modulus, p);
+
+        a.resize(k);
+        for (size_t i = 0; i < k; i++) {
+            a[i] = (a[i] + p - qf[i]) % p;
+        }
+
+        return a;
+    }
+};
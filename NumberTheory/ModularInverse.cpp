@@ -0,0 +1,133 @@
+/*
+ * name: 批量求逆元、线性逆元表、组合数
+ * description:
+ *
+ * 批量求逆元（Montgomery 技巧）：先求前缀积 $s_i = a_1a_2 \ldots a_i$，只对 $s_n$ 做一次拓展欧几里得求逆，再从后往前依次得到每个 $a_i^{-1}$，共 $3N$ 次乘法。
+ *
+ * 线性逆元表：$i^{-1} \equiv -\lfloor p / i \rfloor \cdot (p \bmod i)^{-1} \pmod p$，可在$O(N)$内求出$1$到$N$的逆元，用于阶乘逆元与组合数预处理。
+ *
+ * 注意：p 应为质数（批量求逆只要求各 $a_i$ 与 p 互质），且 $p < 2^{31}$，否则乘法会溢出 i64
+ *
+ * 时间复杂度：批量求逆$O(N + \log{p})$，逆元表$O(N)$，组合数预处理$O(N)$、单次询问$O(1)$
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+typedef long long number;
+
+// d = gcd(a, b) = ax + by
+struct EEResult {
+    number d;
+    number x;
+    number y;
+};
+
+EEResult exgcd(number a, number b) {
+    a = std::abs(a);
+    b = std::abs(b);
+
+    number x = 1, y = 0;
+
+    number x1 = 0, y1 = 1, a1 = a, b1 = b;
+    while (b1 > 0) {
+        number q = a1 / b1;
+        std::tie(x, x1) = std::make_tuple(x1, x - q * x1);
+        std::tie(y, y1) = std::make_tuple(y1, y - q * y1);
+        std::tie(a1, b1) = std::make_tuple(b1, a1 - q * b1);
+    }
+    return EEResult{a1, x, y};
+}
+
+// a 在模 p 下的逆元，要求 gcd(a, p) = 1
+number modular_inverse(number a, number p) {
+    EEResult r = exgcd(a % p, p);
+
+    return ((r.x % p) + p) % p;
+}
+
+// 返回 a_list 中每个数在模 p 下的逆元，只调用一次 exgcd
+// 要求每个 a_i 都与 p 互质（即 a_i mod p != 0）
+std::vector<number> batch_modular_inverse(std::vector<number> const &a_list,
+                                          number p) {
+    size_t n = a_list.size();
+
+    std::vector<number> result;
+    result.resize(n);
+
+    if (n == 0) {
+        return result;
+    }
+
+    // result[i] 暂存前缀积 a_0a_1...a_i
+    number prefix = 1;
+    for (size_t i = 0; i < n; i++) {
+        prefix = prefix * (((a_list[i] % p) + p) % p) % p;
+        result[i] = prefix;
+    }
+
+    // inv 为 (a_0a_1...a_i)^{-1}
+    number inv = modular_inverse(prefix, p);
+
+    for (size_t i = n - 1; i > 0; i--) {
+        number a_i = ((a_list[i] % p) + p) % p;
+
+        result[i] = inv * result[i - 1] % p;
+        inv = inv * a_i % p;
+    }
+
+    result[0] = inv;
+
+    return result;
+}
+
+// result[i] 为 i 在模 p 下的逆元（1 <= i <= n），result[0] 无意义，要求 n < p
+std::vector<number> inverse_table(size_t n, number p) {
+    std::vector<number> result;
+    result.resize(n + 1, 0);
+
+    if (n >= 1) {
+        result[1] = 1;
+    }
+
+    for (size_t i = 2; i <= n; i++) {
+        number i_ = (number)i;
+
+        result[i] = (p - p / i_) * result[(size_t)(p % i_)] % p;
+    }
+
+    return result;
+}
+
+// 阶乘、阶乘逆元预处理，用于 O(1) 求组合数，要求 n < p
+struct Binomial {
+    number p;
+    std::vector<number> factorial;
+    std::vector<number> inverse_factorial;
+
+    explicit Binomial(size_t n, number p_) : p{p_} {
+        std::vector<number> inverse = inverse_table(n, p);
+
+        factorial.resize(n + 1);
+        inverse_factorial.resize(n + 1);
+
+        factorial[0] = inverse_factorial[0] = 1;
+
+        for (size_t i = 1; i <= n; i++) {
+            factorial[i] = factorial[i - 1] * (number)i % p;
+            inverse_factorial[i] = inverse_factorial[i - 1] * inverse[i] % p;
+        }
+    }
+
+    // C(n, k) mod p
+    number choose(size_t n, size_t k) const {
+        if (k > n) {
+            return 0;
+        }
+
+        return factorial[n] * inverse_factorial[k] % p *
+               inverse_factorial[n - k] % p;
+    }
+};